@@ -1,16 +0,0 @@
-#version 330 core
-
-layout (location = 0) in vec2 a_Position;
-layout (location = 1) in vec2 a_TexCoords;
-
-out vec2 v_TexCoords;
-
-uniform mat4 u_Model;
-uniform mat4 u_View;
-uniform mat4 u_Projection;
-
-void main()
-{
-    v_TexCoords = a_TexCoords;
-    gl_Position = u_Projection * u_View * u_Model * vec4(a_Position, 0.0f, 1.0f);
-}
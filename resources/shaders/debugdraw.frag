@@ -0,0 +1,10 @@
+#version 330 core
+
+out vec4 f_color;
+
+in vec4 v_Color;
+
+void main()
+{
+    f_color = v_Color;
+}
@@ -0,0 +1,18 @@
+#version 330 core
+
+layout (location = 0) in vec2 a_Position; // world space.
+layout (location = 1) in vec4 a_Color;
+
+out vec4 v_Color;
+
+layout (std140) uniform Camera
+{
+    mat4 u_View;
+    mat4 u_Projection;
+};
+
+void main()
+{
+    v_Color     = a_Color;
+    gl_Position = u_Projection * u_View * vec4(a_Position, 0.0, 1.0);
+}
@@ -0,0 +1,10 @@
+#version 330 core
+
+out vec4 f_color;
+
+uniform vec4 u_Color;
+
+void main()
+{
+    f_color = u_Color;
+}
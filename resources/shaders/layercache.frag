@@ -3,9 +3,9 @@
 out vec4 f_color;
 
 in vec2 v_TexCoords;
-uniform sampler2D u_Texture;
+uniform sampler2D u_Layer;
 
 void main()
 {
-    f_color = texture(u_Texture, v_TexCoords);
+    f_color = texture(u_Layer, v_TexCoords);
 }
@@ -0,0 +1,25 @@
+#version 330 core
+
+// Unit quad, u_Model places it over the cached world rectangle.
+layout (location = 0) in vec2 a_Position;
+
+out vec2 v_TexCoords;
+
+layout (std140) uniform Camera
+{
+    mat4 u_View;
+    mat4 u_Projection;
+};
+
+uniform vec3 u_Model[2]; // Renderer::Affine2D rows.
+uniform float u_Depth;    // NDC z, ranked by RenderQueue.
+
+void main()
+{
+    vec3 position = vec3(a_Position, 1.0f);
+    vec2 world    = vec2(dot(u_Model[0], position), dot(u_Model[1], position));
+
+    v_TexCoords = a_Position;
+    gl_Position = u_Projection * u_View * vec4(world, 0.0f, 1.0f);
+    gl_Position.z = u_Depth;
+}
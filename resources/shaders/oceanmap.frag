@@ -2,10 +2,42 @@
 
 out vec4 f_color;
 
-in vec2 v_Texcoords;
-uniform sampler2D u_Texture;
+in vec2 v_WorldPosition;
+
+// Toroidal window of streamed chunks, world tile (x, y) lives at texel (x mod w, y mod h).
+uniform usampler2D u_TileMap;
+uniform sampler2D  u_Atlas;
+
+uniform float u_TileSize;     // world units per tile.
+uniform ivec2 u_AtlasGrid;    // tiles per atlas row and column.
+
+const uint k_UnloadedTile = 0xFFFFu;
+const vec4 k_OpenWater    = vec4(0.09f, 0.33f, 0.55f, 1.0f);
 
 void main()
 {
-    f_color = texture(u_Texture, v_Texcoords);
+    vec2 tileCoord = v_WorldPosition / u_TileSize;
+
+    // GLSL leaves % undefined for negative operands, wrap with floor instead.
+    vec2 mapSize = vec2(textureSize(u_TileMap, 0));
+    ivec2 texel = min(ivec2(floor(tileCoord - mapSize * floor(tileCoord / mapSize))), ivec2(mapSize) - 1);
+
+    uint index = texelFetch(u_TileMap, texel, 0).r;
+    if (index == k_UnloadedTile)
+    {
+        // Chunk still streaming in.
+        f_color = k_OpenWater;
+        return;
+    }
+
+    vec2 cell = vec2(int(index) % u_AtlasGrid.x, int(index) / u_AtlasGrid.x);
+
+    // Inset by half a texel so linear filtering never reads a neighbouring atlas tile.
+    vec2 grid = vec2(u_AtlasGrid);
+    vec2 halfTexel = 0.5f / vec2(textureSize(u_Atlas, 0)) * grid;
+    vec2 local = clamp(fract(tileCoord), halfTexel, 1.0f - halfTexel);
+
+    // Gradients of the continuous coordinate keep mip selection smooth across tile edges.
+    vec2 gradient = tileCoord / grid;
+    f_color = textureGrad(u_Atlas, (cell + local) / grid, dFdx(gradient), dFdy(gradient));
 }
@@ -1,20 +1,18 @@
 #version 330 core
 
+// Quad covering the render target in normalized device coordinates.
 layout (location = 0) in vec2 aPosition;
-layout (location = 1) in vec2 aTexcoords;
 
-layout (location = 2) in vec2 aInstanceTranslation;
+out vec2 v_WorldPosition;
 
-out vec2 v_Texcoords;
+// World rectangle {left, bottom, right, top} the target shows: the camera's view, or the
+// rectangle of a layer cache being rendered.
+uniform vec4 u_WorldRect;
 
-uniform mat4 u_Model;
-uniform mat4 u_View;
-uniform mat4 u_Projection;
+uniform float u_Depth; // NDC z, ranked by RenderQueue.
 
 void main()
 {
-    v_Texcoords = aTexcoords;
-    vec4 modelPos = u_Model * vec4(aPosition, 0.0f, 1.0f);
-    vec4 worldPos = modelPos + vec4(aInstanceTranslation, 0.0f, 0.0f);
-    gl_Position = u_Projection * u_View * worldPos;
+    v_WorldPosition = mix(u_WorldRect.xy, u_WorldRect.zw, aPosition * 0.5f + 0.5f);
+    gl_Position = vec4(aPosition, u_Depth, 1.0f);
 }
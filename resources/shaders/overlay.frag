@@ -0,0 +1,14 @@
+#version 330 core
+
+out vec4 f_color;
+
+in vec2 v_TexCoords;
+in vec4 v_Color;
+
+// Glyph coverage in the red channel, see BitmapFont.
+uniform sampler2D u_Font;
+
+void main()
+{
+    f_color = vec4(v_Color.rgb, v_Color.a * texture(u_Font, v_TexCoords).r);
+}
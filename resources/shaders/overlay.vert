@@ -0,0 +1,20 @@
+#version 330 core
+
+layout (location = 0) in vec2 a_Position;  // pixels from the top-left corner.
+layout (location = 1) in vec2 a_TexCoords;
+layout (location = 2) in vec4 a_Color;
+
+out vec2 v_TexCoords;
+out vec4 v_Color;
+
+uniform vec2 u_Screen;
+uniform float u_Depth; // NDC z, ranked by RenderQueue.
+
+void main()
+{
+    vec2 ndc = a_Position / u_Screen * 2.0 - 1.0;
+
+    v_TexCoords = a_TexCoords;
+    v_Color     = a_Color;
+    gl_Position = vec4(ndc.x, -ndc.y, u_Depth, 1.0);
+}
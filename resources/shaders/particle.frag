@@ -0,0 +1,19 @@
+#version 330 core
+
+out vec4 f_color;
+
+in vec2 v_Local;  // -1 to 1 across the quad.
+in float v_Alpha;
+
+uniform sampler2D u_Atlas;
+uniform int u_Textured;
+uniform vec4 u_Color;
+
+void main()
+{
+    vec4 color = u_Textured != 0
+        ? texture(u_Atlas, v_Local * 0.5 + 0.5)
+        : vec4(1.0, 1.0, 1.0, 1.0 - smoothstep(0.4, 1.0, length(v_Local)));
+
+    f_color = vec4(u_Color.rgb * color.rgb, u_Color.a * color.a * v_Alpha);
+}
@@ -0,0 +1,23 @@
+#version 330 core
+
+layout (location = 0) in vec2 a_Corner;   // unit quad, -0.5 to 0.5.
+layout (location = 1) in vec4 i_Particle; // position xy, size z, alpha w.
+
+out vec2 v_Local;
+out float v_Alpha;
+
+layout (std140) uniform Camera
+{
+    mat4 u_View;
+    mat4 u_Projection;
+};
+
+uniform float u_Depth; // NDC z, ranked by RenderQueue.
+
+void main()
+{
+    v_Local     = a_Corner * 2.0;
+    v_Alpha     = i_Particle.w;
+    gl_Position = u_Projection * u_View * vec4(i_Particle.xy + a_Corner * i_Particle.z, 0.0, 1.0);
+    gl_Position.z = u_Depth;
+}
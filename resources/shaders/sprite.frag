@@ -0,0 +1,38 @@
+#version 330 core
+
+out vec4 f_color;
+
+in vec2 v_TexCoords;
+flat in int v_TextureUnit;
+
+// GLSL 3.30 only indexes sampler arrays with constants, hence the switch. Keep the size in sync
+// with SpriteBatch::k_MaxTextureUnits.
+uniform sampler2D u_Textures[16];
+
+void main()
+{
+    // Derivatives taken outside the switch, implicit ones are undefined in divergent branches.
+    vec2 dx = dFdx(v_TexCoords);
+    vec2 dy = dFdy(v_TexCoords);
+
+    switch (v_TextureUnit)
+    {
+        case 0: f_color = textureGrad(u_Textures[0], v_TexCoords, dx, dy); break;
+        case 1: f_color = textureGrad(u_Textures[1], v_TexCoords, dx, dy); break;
+        case 2: f_color = textureGrad(u_Textures[2], v_TexCoords, dx, dy); break;
+        case 3: f_color = textureGrad(u_Textures[3], v_TexCoords, dx, dy); break;
+        case 4: f_color = textureGrad(u_Textures[4], v_TexCoords, dx, dy); break;
+        case 5: f_color = textureGrad(u_Textures[5], v_TexCoords, dx, dy); break;
+        case 6: f_color = textureGrad(u_Textures[6], v_TexCoords, dx, dy); break;
+        case 7: f_color = textureGrad(u_Textures[7], v_TexCoords, dx, dy); break;
+        case 8: f_color = textureGrad(u_Textures[8], v_TexCoords, dx, dy); break;
+        case 9: f_color = textureGrad(u_Textures[9], v_TexCoords, dx, dy); break;
+        case 10: f_color = textureGrad(u_Textures[10], v_TexCoords, dx, dy); break;
+        case 11: f_color = textureGrad(u_Textures[11], v_TexCoords, dx, dy); break;
+        case 12: f_color = textureGrad(u_Textures[12], v_TexCoords, dx, dy); break;
+        case 13: f_color = textureGrad(u_Textures[13], v_TexCoords, dx, dy); break;
+        case 14: f_color = textureGrad(u_Textures[14], v_TexCoords, dx, dy); break;
+        case 15: f_color = textureGrad(u_Textures[15], v_TexCoords, dx, dy); break;
+        default: f_color = vec4(1.0, 0.0, 1.0, 1.0); break;
+    }
+}
@@ -0,0 +1,33 @@
+#version 330 core
+
+layout (location = 0) in vec2 a_Corner;       // unit quad, -0.5 to 0.5.
+layout (location = 1) in vec2 i_Center;
+layout (location = 2) in vec2 i_Size;
+layout (location = 3) in vec4 i_UVRect;       // min uv xy, max uv zw.
+layout (location = 4) in float i_Rotation;    // fraction of pi.
+layout (location = 5) in int i_TextureUnit;
+layout (location = 6) in float i_Depth;       // NDC z, ranked by RenderQueue.
+
+const float PI = 3.14159265;
+
+out vec2 v_TexCoords;
+flat out int v_TextureUnit;
+
+layout (std140) uniform Camera
+{
+    mat4 u_View;
+    mat4 u_Projection;
+};
+
+void main()
+{
+    vec2 local = a_Corner * i_Size;
+    float c = cos(i_Rotation * PI);
+    float s = sin(i_Rotation * PI);
+    vec2 world = i_Center + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+    v_TexCoords   = mix(i_UVRect.xy, i_UVRect.zw, a_Corner + 0.5);
+    v_TextureUnit = i_TextureUnit;
+    gl_Position   = u_Projection * u_View * vec4(world, 0.0, 1.0);
+    gl_Position.z = i_Depth;
+}
@@ -0,0 +1,170 @@
+#include "core/HeadlessContext.h"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <stdexcept>
+#include <string_view>
+
+#include <EGL/eglext.h>
+
+namespace Core
+{
+namespace
+{
+    bool HasExtension(const char* extensions, std::string_view name)
+    {
+        if (!extensions)
+        {
+            return false;
+        }
+
+        const std::string_view list {extensions};
+        for (std::size_t start {0}; start < list.size();)
+        {
+            const auto end {std::min(list.find(' ', start), list.size())};
+            if (list.substr(start, end - start) == name)
+            {
+                return true;
+            }
+            start = end + 1;
+        }
+        return false;
+    }
+
+    /*
+    * Mesa's surfaceless platform needs no X11, Wayland or DRM device; fall back to the default
+    * display everywhere else.
+    */
+    EGLDisplay OpenDisplay()
+    {
+        const char* clientExtensions {eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS)};
+        if (HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+        {
+            auto getPlatformDisplay {reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"))};
+            if (getPlatformDisplay)
+            {
+                if (EGLDisplay display {getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr)}; display != EGL_NO_DISPLAY)
+                {
+                    return display;
+                }
+            }
+        }
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+}// anonymous namespace
+
+/*
+* Creates the context and makes it current on the calling thread.
+*/
+HeadlessContext::HeadlessContext(unsigned int width, unsigned int height):
+m_display(EGL_NO_DISPLAY),
+m_context(EGL_NO_CONTEXT),
+m_surface(EGL_NO_SURFACE)
+{
+    m_display = OpenDisplay();
+    if (m_display == EGL_NO_DISPLAY || !eglInitialize(m_display, nullptr, nullptr))
+    {
+        throw std::runtime_error(std::format("Failed to initialize EGL display, error 0x{:x}.", eglGetError()));
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        Destroy();
+        throw std::runtime_error("EGL display does not support desktop OpenGL.");
+    }
+
+    const bool surfaceless {HasExtension(eglQueryString(m_display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")};
+
+    const std::array<EGLint, 13> configAttributes
+    {
+        EGL_SURFACE_TYPE,    surfaceless ? 0 : EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE,   8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE,  8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+
+    EGLConfig config {};
+    EGLint configCount {0};
+    if (!eglChooseConfig(m_display, configAttributes.data(), &config, 1, &configCount) || configCount == 0)
+    {
+        Destroy();
+        throw std::runtime_error("No EGL config for an RGBA8 OpenGL context.");
+    }
+
+    // Same version and profile the windowed path asks GLFW for.
+    constexpr std::array<EGLint, 7> contextAttributes
+    {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+
+    m_context = eglCreateContext(m_display, config, EGL_NO_CONTEXT, contextAttributes.data());
+    if (m_context == EGL_NO_CONTEXT)
+    {
+        Destroy();
+        throw std::runtime_error(std::format("Failed to create OpenGL 3.3 core context, EGL error 0x{:x}.", eglGetError()));
+    }
+
+    if (!surfaceless)
+    {
+        const std::array<EGLint, 5> surfaceAttributes
+        {
+            EGL_WIDTH,  static_cast<EGLint>(width),
+            EGL_HEIGHT, static_cast<EGLint>(height),
+            EGL_NONE
+        };
+
+        m_surface = eglCreatePbufferSurface(m_display, config, surfaceAttributes.data());
+        if (m_surface == EGL_NO_SURFACE)
+        {
+            Destroy();
+            throw std::runtime_error(std::format("Failed to create EGL pbuffer, error 0x{:x}.", eglGetError()));
+        }
+    }
+
+    if (!eglMakeCurrent(m_display, m_surface, m_surface, m_context))
+    {
+        Destroy();
+        throw std::runtime_error(std::format("Failed to make EGL context current, error 0x{:x}.", eglGetError()));
+    }
+}
+
+HeadlessContext::~HeadlessContext()
+{
+    Destroy();
+}
+
+void HeadlessContext::Destroy()
+{
+    if (m_display == EGL_NO_DISPLAY)
+    {
+        return;
+    }
+
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_surface != EGL_NO_SURFACE)
+    {
+        eglDestroySurface(m_display, m_surface);
+    }
+    if (m_context != EGL_NO_CONTEXT)
+    {
+        eglDestroyContext(m_display, m_context);
+    }
+    eglTerminate(m_display);
+
+    m_surface = EGL_NO_SURFACE;
+    m_context = EGL_NO_CONTEXT;
+    m_display = EGL_NO_DISPLAY;
+}
+
+bool HeadlessContext::IsSurfaceless() const noexcept
+{
+    return m_surface == EGL_NO_SURFACE;
+}
+}// namespace Core
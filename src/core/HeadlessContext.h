@@ -0,0 +1,37 @@
+#ifndef HEADLESSCONTEXT_H
+#define HEADLESSCONTEXT_H
+
+#include <EGL/egl.h>
+
+namespace Core
+{
+/*
+* OpenGL 3.3 core context without a window, created through EGL so it works on machines with no
+* display server (CI runners with Mesa llvmpipe). Uses a surfaceless display and context when the
+* driver supports it, otherwise a pbuffer surface of the given size. Nothing is ever presented,
+* frames are rendered into a Renderer::Framebuffer.
+*/
+class HeadlessContext
+{
+private:
+
+    EGLDisplay m_display;
+    EGLContext m_context;
+    EGLSurface m_surface;
+
+public:
+
+    HeadlessContext(unsigned int width, unsigned int height);
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&)            = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+    HeadlessContext(HeadlessContext&&)                 = delete;
+    HeadlessContext& operator=(HeadlessContext&&)      = delete;
+
+    void Destroy();
+    bool IsSurfaceless() const noexcept;
+};
+}// namespace Core
+
+#endif
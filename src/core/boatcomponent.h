@@ -4,6 +4,7 @@
 #include "core/world.h"
 
 #include <glm/trigonometric.hpp>
+#include <glm/ext/vector_float2.hpp>
 #include <glm/ext/vector_float3.hpp>
 
 namespace World
@@ -40,12 +41,6 @@ class BoatComponent: public WorldComponent
 
     public:
 
-        struct Vertex
-        {
-            glm::vec2 position;
-            glm::vec2 texcoords;
-        };
-
         using WorldComponent::WorldComponent;
         BoatComponent(Id id, std::string name, glm::vec3 position, BoatType boatType):
             WorldComponent::WorldComponent(id, name),
@@ -62,7 +57,7 @@ class BoatComponent: public WorldComponent
 
         virtual void OnEvent(Event::Event&) override       {}
         virtual void OnUpdate(float deltaSeconds) override {}
-        virtual void OnRender() const override             {}
+        virtual void OnRender(Renderer::RenderQueue&) const override {}
 
         virtual void SetAccelerationInput(float dir) {_accelInput = dir;};
         virtual void SetRotationInput(float dir)     {_rotationInput = dir;};
@@ -72,6 +67,10 @@ class BoatComponent: public WorldComponent
         virtual glm::vec3 GetPosition() const noexcept override {return _position;}
         virtual void SetPosition(const glm::vec3& pos) {_position = pos;}
         virtual BoatType GetType() const               {return _boatType;}
+
+        float GetSpeed() const noexcept    {return _speed;}
+        float GetMaxSpeed() const noexcept {return _maxSpeed;}
+        virtual glm::vec2 GetForward() const noexcept  {return {glm::cos(_rotation), glm::sin(_rotation)};}
 };
 }// namespace World
 
@@ -40,14 +40,26 @@ class CompositeComponent: public WorldComponent
             }
         }
 
-        void OnRender() const override
+        void OnRender(Renderer::RenderQueue& queue) const override
         {
             for (const auto& child: _children)
             {
-                child->OnRender();
+                child->OnRender(queue);
             }
         }
 
+        bool NeedsRedraw() const override
+        {
+            for (const auto& child: _children)
+            {
+                if (child->NeedsRedraw())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         void AddChildren(std::shared_ptr<WorldComponent> child) override
         {
             _children.push_back(std::move(child));
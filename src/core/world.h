@@ -9,6 +9,11 @@
 
 #include "events/Events.h"
 
+namespace Renderer
+{
+class RenderQueue;
+}// namespace Renderer
+
 namespace World
 {
 
@@ -37,7 +42,11 @@ class WorldComponent
 
         virtual void OnEvent(Event::Event&) {}
         virtual void OnUpdate(float deltaSeconds = 0) {}
-        virtual void OnRender() const {}
+        virtual void OnRender(Renderer::RenderQueue&) const {}
+
+        // True while the component changes without input (moving, animating, loading); on-demand
+        // rendering keeps drawing frames until every layer returns false.
+        virtual bool NeedsRedraw() const {return false;}
 
         virtual void AddChildren(std::shared_ptr<WorldComponent>) {}
         virtual void RemoveChildren(Id) {}
@@ -2,93 +2,30 @@
 #include "core/world.h"
 #include "events/Events.h"
 #include "events/KeyEvents.h"
+#include "renderer/DebugDraw.h"
 
-#include <glm/ext/matrix_transform.hpp>
-#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/gtc/constants.hpp>
 #include <GLFW/glfw3.h>
 
+#include <cmath>
 #include <filesystem>
 
 namespace Entity
 {
 namespace
 {
-    const std::filesystem::path k_VertexShader   {"resources/shaders/boat.vert"};
-    const std::filesystem::path k_FragmentShader {"resources/shaders/boat.frag"};
-    const std::filesystem::path k_TexturePath    {"resources/images/world/PNG/Boat1_water_animation_color1/Boat1_water_frame1.png"};
+    const std::filesystem::path k_TexturePath {"resources/images/world/PNG/Boat1_water_animation_color1/Boat1_water_frame1.png"};
 
-    // TODO
-    constexpr int k_TextureIndex {1};
     constexpr float k_ForwardOffset {-glm::half_pi<float>()};
     constexpr float k_QuadHalfWidth  {64.0f};
     constexpr float k_QuadHalfHeight {64.0f};
-
-    constexpr std::array<World::BoatComponent::Vertex, 4> k_QuadVertices =
-    {{
-         {{-k_QuadHalfWidth, k_QuadHalfHeight},  {0.0f, 1.0f}},// top-left
-         {{-k_QuadHalfWidth, -k_QuadHalfHeight}, {0.0f, 0.0f}},// bot-left
-         {{k_QuadHalfWidth, -k_QuadHalfHeight},  {1.0f, 0.0f}},// bot-right
-         {{k_QuadHalfWidth, k_QuadHalfHeight},   {1.0f, 1.0f}},// top-right
-    }};
-
-    constexpr std::array<GLuint, 6> k_IndexBuffer =
-    {
-        0, 1, 2, 2, 3, 0
-    };
-
 }// anonymous namespace
 
+// Drawn as a sprite, the batch picks the texture unit.
 PlayerBoat::PlayerBoat(const std::string& playerName, const glm::vec3& position):
     World::BoatComponent(World::GenerateComponentId(), playerName, position, World::BoatType::USER),
-    m_shader(k_VertexShader, k_FragmentShader),
-    m_texture(k_TexturePath, k_TextureIndex)
-{
-    glGenVertexArrays(1, &m_VAO);
-    glBindVertexArray(m_VAO);
-
-    glGenBuffers(1, &m_VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(World::BoatComponent::Vertex) * k_QuadVertices.size(), k_QuadVertices.data(), GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(World::BoatComponent::Vertex), reinterpret_cast<void*>(offsetof(World::BoatComponent::Vertex, position)));
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(World::BoatComponent::Vertex), reinterpret_cast<void*>(offsetof(World::BoatComponent::Vertex, texcoords)));
-    glEnableVertexAttribArray(1);
-
-    glGenBuffers(1, &m_EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * k_IndexBuffer.size(), k_IndexBuffer.data(), GL_STATIC_DRAW);
-
-    m_model = glm::mat4(1.0f);
-    m_model = glm::translate(m_model, _position);
-    // m_model = glm::scale(m_model, glm::vec3(_scale, _scale, _scale));
-    m_projection = glm::ortho(0.0f, 1024.0f, 0.0f, 1024.0f, -0.1f, 100.0f);
-    m_view = glm::lookAt
-        (
-         glm::vec3(0.0f, 0.0f, 50.0f),
-         glm::vec3(0.0f, 0.0f, 0.0f),
-         glm::vec3(0.0f, 1.0f, 0.0f)
-        );
-
-    m_shader.Bind();
-    m_texture.Bind();
-
-    m_shader.SetUniformMat4f("u_Model", m_model);
-    m_shader.SetUniformMat4f("u_Projection", m_projection);
-    m_shader.SetUniformMat4f("u_View", m_view);
-    m_shader.SetUniform1i("u_Texture", k_TextureIndex);
-
-    m_texture.UnBind();
-    m_shader.UnBind();
-}
-
-PlayerBoat::~PlayerBoat()
-{
-    glDeleteBuffers(1, &m_VBO);
-    glDeleteBuffers(1, &m_EBO);
-    glDeleteVertexArrays(1, &m_VAO);
-}
+    m_texture(Renderer::TextureLoader::Instance().Load(k_TexturePath, 0))
+{}
 
 void PlayerBoat::OnEvent(Event::Event& event)
 {
@@ -116,25 +53,49 @@ void PlayerBoat::OnUpdate(float deltaSeconds)
     auto angle = _rotation + k_ForwardOffset;
     glm::vec3 forward (std::cos(angle), std::sin(angle), 0.0f);
     _position += forward * _speed * deltaSeconds;
-
-    m_model = glm::mat4(1.0f);
-    m_model = glm::translate(m_model, _position);
-    // m_model = glm::scale(m_model, glm::vec3(_scale, _scale, _scale));
-    m_model = glm::rotate(m_model, _rotation, glm::vec3(0.0f, 0.0f, 1.0f));
 }
 
-void PlayerBoat::OnRender() const
+/*
+ * Submits the boat quad when on screen, boats farther up the map are drawn first so nearer boats overlap them.
+ */
+void PlayerBoat::OnRender(Renderer::RenderQueue& queue) const
 {
-    m_shader.Bind();
-    m_shader.SetUniformMat4f("u_Model", m_model);
+    if (!queue.Cull(GetAABB()))
+    {
+        return;
+    }
+
+    Renderer::Sprite sprite
+    {
+        .position = glm::vec2{_position},
+        .size     = glm::vec2{k_QuadHalfWidth * 2.0f, k_QuadHalfHeight * 2.0f},
+        .rotation = _rotation,
+        .texture  = m_texture->GetID(),
+    };
 
-    m_texture.Bind();
-    glBindVertexArray(m_VAO);
-    glDrawElements(GL_TRIANGLES, k_IndexBuffer.size(), GL_UNSIGNED_INT, nullptr);
-    glBindVertexArray(0);
-    m_texture.UnBind();
+    queue.SubmitSprite(sprite, _position.y);
 
-    m_shader.UnBind();
+    // Bounds used for culling, and where the boat is heading.
+    const glm::vec2 heading {GetForward()};
+    Renderer::DebugDraw::Box(GetAABB(), Renderer::PackColor(0, 255, 0));
+    Renderer::DebugDraw::Arrow(sprite.position, sprite.position + heading * k_QuadHalfHeight, Renderer::PackColor(255, 255, 0));
+}
+
+/*
+ * The sprite faces up at rotation 0.
+ */
+glm::vec2 PlayerBoat::GetForward() const noexcept
+{
+    const float angle {_rotation + k_ForwardOffset};
+    return {std::cos(angle), std::sin(angle)};
+}
+
+/*
+ * Moving or steering, drag keeps the boat gliding after the keys are released.
+ */
+bool PlayerBoat::NeedsRedraw() const
+{
+    return _speed != 0.0f || _accelInput != 0.0f || _rotationInput != 0.0f;
 }
 
 glm::vec2 PlayerBoat::GetSize() const noexcept
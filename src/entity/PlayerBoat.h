@@ -6,8 +6,8 @@
 #include "events/Events.h"
 #include "events/KeyEvents.h"
 
-#include "renderer/Shader.h"
-#include "renderer/Texture2D.h"
+#include "renderer/RenderQueue.h"
+#include "renderer/TextureLoader.h"
 
 namespace Entity
 {
@@ -15,16 +15,7 @@ class PlayerBoat: public World::BoatComponent
 {
     private:
 
-        GLuint m_VAO;
-        GLuint m_VBO;
-        GLuint m_EBO;
-
-        glm::mat4 m_model;
-        glm::mat4 m_view;
-        glm::mat4 m_projection;
-
-        Renderer::Shader    m_shader;
-        Renderer::Texture2D m_texture;
+        Renderer::TextureHandle m_texture; // placeholder until loaded.
 
         bool OnKeyPressed(const Event::KeyPressedEvent& event);
         bool OnKeyReleased(const Event::KeyReleasedEvent& event);
@@ -32,14 +23,15 @@ class PlayerBoat: public World::BoatComponent
     public:
 
         PlayerBoat(const std::string& playerName, const glm::vec3& position);
-        ~PlayerBoat();
 
         void OnEvent(Event::Event&) override;
         void OnUpdate(float deltaSeconds) override;
-        void OnRender() const override;
+        void OnRender(Renderer::RenderQueue& queue) const override;
+        bool NeedsRedraw() const override;
 
         glm::vec2 GetSize() const noexcept override;
         glm::vec4 GetAABB() const noexcept override;
+        glm::vec2 GetForward() const noexcept override;
 };
 }// namespace Entity
 
@@ -1,51 +0,0 @@
-#ifndef TRAIN_H
-#define TRAIN_H
-
-#include <memory>
-#include <vector>
-
-#include <glm/glm.hpp>
-
-#include "renderer/Texture2D.h"
-
-namespace Entity
-{
-// Holds model data and reference to a texture for this given train.
-struct Train
-{
-    enum class Direction: int
-    {
-        FORWARD = 1,
-        REVERSE = -1
-    };
-
-    Direction m_direction;
-
-    // Train Texture.
-    std::shared_ptr<Renderer::Texture2D> m_texture;
-
-    // Train Model data.
-    glm::vec2 m_position;
-    glm::vec2 m_size;
-    glm::vec2 m_velocity;
-
-    float m_speed;
-    float m_rotation;
-
-    // Current index along path, and progress to next index.
-    float m_segmentProgress;
-    int m_currentSegment;
-
-    // Train path to follow using linear interpolation.
-    std::vector<glm::vec2> m_path;
-
-    Train();
-    Train(std::shared_ptr<Renderer::Texture2D> texture, glm::vec2 size, glm::vec2 velocity);
-
-    ~Train() = default;
-
-    void Travel(float deltaTime);
-    void SetPath(const std::vector<glm::vec2>& path);
-};
-}// namespace Entity
-#endif
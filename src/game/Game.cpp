@@ -1,17 +1,74 @@
 #include "game/Game.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
+#include <format>
 #include <print>
 #include <cstdio>
+#include <span>
+#include <thread>
+#include <tuple>
 
 #include <GL/gl.h>
 #include <GLFW/glfw3.h>
 
 #include "events/Events.h"
+#include "managers/ResourceManager.h"
+#include "renderer/DebugDraw.h"
+#include "renderer/GeometryRegistry.h"
+#include "renderer/ShaderCache.h"
+#include "renderer/Texture2D.h"
+#include "renderer/TextureLoader.h"
+#include "utility/ResourcePack.h"
 
 namespace Core
 {
+namespace
+{
+    // Longest sleep with on-demand rendering, bounds how late a wake-up nobody signalled can be.
+    constexpr double k_IdleTimeout {0.5};
+
+    // Shows and hides Renderer::DebugDraw shapes in debug builds.
+    constexpr int k_DebugDrawKey {GLFW_KEY_F2};
+
+    // Toggles the overdraw heatmap, turning it off prints the per-layer report.
+    constexpr int k_OverdrawKey {GLFW_KEY_F4};
+
+    // Headless frames simulate a fixed step so runs are repeatable.
+    constexpr float k_HeadlessTimeStep {1.0f / 60.0f};
+
+    // Render queue sort threads, only used for frames with thousands of commands.
+    constexpr unsigned int k_MaxSortWorkers {4};
+
+    float MillisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /*
+    * Depth is cleared every frame, colour only when something may leave pixels uncovered.
+    */
+    void ClearFrame(bool color)
+    {
+        glClearColor(1.0f, 0.0f, 1.0f, 1.0f);
+        glClearDepth(1.0);
+        glDepthMask(GL_TRUE);
+        glClear(GL_DEPTH_BUFFER_BIT | (color ? GL_COLOR_BUFFER_BIT : 0));
+    }
+
+    std::size_t CountComponents(const World::WorldComponent& component)
+    {
+        std::size_t count {1};
+        for (const auto& child: component.GetChildren())
+        {
+            count += CountComponents(*child);
+        }
+        return count;
+    }
+}// anonymous namespace
+
 /*
  * Set GLFW to call this function in case of error.
  */
@@ -21,70 +78,260 @@ static void GLFWErrorCallback(int error, const char* description)
 }
 
 Game::Game(const ApplicationSpecification& specification):
-m_specification(specification)
+m_specification(specification),
+m_redraw(true),
+m_overdrawFrames(0)
 {
-    glfwSetErrorCallback(GLFWErrorCallback);
-    if (!glfwInit())
+    if (std::filesystem::exists(m_specification.resourcePack))
     {
-        assert(false && "Failed to intialize GLFW.");
+        Utility::MountResourcePack(m_specification.resourcePack);
     }
+    Renderer::Texture2D::SetCookedDirectory(m_specification.cookedDirectory);
+
+    float width {static_cast<float>(m_specification.windowspec.width)};
+    float height {static_cast<float>(m_specification.windowspec.height)};
 
-    // Set window specification and create the glfw window context.
-    if (m_specification.windowspec.title.empty())
+    if (m_specification.headless)
     {
-        m_specification.windowspec.title = m_specification.name;
+        // Throws when no EGL driver can give a 3.3 core context.
+        m_headless = std::make_unique<HeadlessContext>(m_specification.windowspec.width, m_specification.windowspec.height);
     }
+    else
+    {
+        glfwSetErrorCallback(GLFWErrorCallback);
+        if (!glfwInit())
+        {
+            assert(false && "Failed to intialize GLFW.");
+        }
+
+        // Set window specification and create the glfw window context.
+        if (m_specification.windowspec.title.empty())
+        {
+            m_specification.windowspec.title = m_specification.name;
+        }
+
+        // set event callable and create window.
+        m_specification.windowspec.EventCallback = [this](Event::Event &event) {this->RaiseEvent(event);};
+        m_window = std::make_shared<Window>(m_specification.windowspec);
 
-    // set event callable and create window.
-    m_specification.windowspec.EventCallback = [this](Event::Event &event) {this->RaiseEvent(event);};
-    m_window = std::make_shared<Window>(m_specification.windowspec);
+        std::tie(width, height) = m_window->GetFrameBufferSize();
+    }
 
-    // OpenGL configuration.
-    if (GLenum err = glewInit(); err != GLEW_OK)
+    // OpenGL configuration. GLEW built for GLX reports a missing GLX display under EGL, the core
+    // entry points are loaded regardless.
+    if (GLenum err = glewInit(); err != GLEW_OK && !(m_headless && err == GLEW_ERROR_NO_GLX_DISPLAY))
     {
         std::println(stderr, "Failed to Initialize GLEW need a valid OpenGL Context:\nError: {}", reinterpret_cast<const char *>(glewGetErrorString(err)));
     }
 
+    if (m_headless)
+    {
+        m_framebuffer = std::make_unique<Renderer::Framebuffer>(static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+        m_framebuffer->Bind();
+    }
+
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Quads and index buffers every renderer draws with.
+    Renderer::GeometryRegistry::Instance().Initialize();
+
+    m_renderQueue.SetSortWorkerCount(std::clamp(std::thread::hardware_concurrency(), 1u, k_MaxSortWorkers));
+    m_renderQueue.SetOverdrawCounting(m_specification.overdraw);
+
+    // Camera uniform block, shared by every shader program.
+    m_camera = std::make_shared<Renderer::CameraBuffer>();
+    m_camera->SetViewport(width, height);
 }
 
 Game::~Game()
 {
+    ReportOverdraw();
+
+    // GPU objects must be released while the context is still alive.
+    m_layerStack.clear();
+    m_renderQueue.Shutdown();
+    Renderer::DebugDraw::Shutdown();
+    m_camera.reset();
+    Manager::ResourceManager::Instance().Clear();
+    Renderer::ShaderCache::Instance().Clear();
+    Renderer::TextureLoader::Instance().Shutdown();
+    Renderer::GeometryRegistry::Instance().Shutdown();
+
+    // Loader threads are joined, nothing references the mapping anymore.
+    Utility::UnmountResourcePack();
+
+    if (m_headless)
+    {
+        m_capture.reset();
+        m_framebuffer.reset();
+        m_headless->Destroy();
+        return;
+    }
+
     m_window->Destroy();
     glfwTerminate();
 }
 
+/*
+ * With ApplicationSpecification::renderOnDemand the loop sleeps in glfwWaitEventsTimeout() while
+ * nothing changes, and a frame is only drawn after input, a resize, or while a layer reports
+ * NeedsRedraw(). Otherwise every iteration draws a frame.
+ */
 void Game::Run()
 {
+    if (m_headless)
+    {
+        RunHeadless();
+        return;
+    }
+
     float lastFrame{};
     float deltaTime{};
     while (!m_window->ShouldClose())
     {
+        if (m_specification.renderOnDemand && !m_redraw && !NeedsRedraw())
+        {
+            glfwWaitEventsTimeout(k_IdleTimeout);
+
+            // Time spent asleep is not simulated.
+            lastFrame = static_cast<float>(glfwGetTime());
+        }
+        else
+        {
+            glfwPollEvents();
+        }
+
         // Calculate delta time and processes callbacks.
         float currentFrame{static_cast<float>(glfwGetTime())};
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
-        glfwPollEvents();
 
+        // Checked before updating too, the update that brings something to rest must still be drawn.
+        const bool active {NeedsRedraw()};
+
+        const auto updateStart {std::chrono::steady_clock::now()};
         this->Update(deltaTime);
+        m_camera->Upload();
 
-        // Clear and Render.
-        glClearColor(1.0f, 0.0f, 1.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        // Finish textures decoded in the background, swapping out their placeholders.
+        Renderer::TextureLoader::Instance().Update();
+        m_timings.update = MillisecondsSince(updateStart);
+        m_timings.frame  = deltaTime * 1000.0f;
+
+        if (!m_specification.renderOnDemand || m_redraw || active || NeedsRedraw())
+        {
+            const auto renderStart {std::chrono::steady_clock::now()};
+
+            this->Render();
+            m_timings.render = MillisecondsSince(renderStart);
+
+            m_window->Update();
+        }
+        m_redraw = false;
+    }
+}
+
+/*
+ * Draws ApplicationSpecification::frameCount frames into the offscreen framebuffer as fast as the
+ * GPU allows, then prints the average frame time. With a capture directory every frame is copied
+ * into a pixel buffer right after drawing and written out a few frames later, once the copy has
+ * finished, so captures do not stall rendering.
+ */
+void Game::RunHeadless()
+{
+    const auto width {m_framebuffer->GetWidth()};
+    const auto height {m_framebuffer->GetHeight()};
+
+    if (const auto directory {m_specification.captureDirectory}; !directory.empty())
+    {
+        std::filesystem::create_directories(directory);
+        m_capture = std::make_unique<Renderer::FrameCapture>([directory](std::uint64_t frame, GLsizei w, GLsizei h, std::span<const std::byte> pixels)
+        {
+            Renderer::WritePPM(directory / std::format("frame_{:05}.ppm", frame), w, h, pixels);
+        });
+    }
 
+    const auto start {std::chrono::steady_clock::now()};
+    auto frameStart {start};
+    for (std::uint64_t frame {0}; frame < m_specification.frameCount; ++frame)
+    {
+        m_timings.frame = MillisecondsSince(frameStart);
+        frameStart      = std::chrono::steady_clock::now();
+
+        this->Update(k_HeadlessTimeStep);
+        m_camera->Upload();
+        Renderer::TextureLoader::Instance().Update();
+        m_timings.update = MillisecondsSince(frameStart);
+
+        const auto renderStart {std::chrono::steady_clock::now()};
+        m_framebuffer->Bind();
         this->Render();
+        m_timings.render = MillisecondsSince(renderStart);
+
+        if (m_capture)
+        {
+            m_capture->Capture(frame, width, height);
+            m_capture->Poll();
+        }
+    }
+
+    if (m_capture)
+    {
+        m_capture->Flush();
+    }
+    glFinish();
+
+    ReportOverdraw();
 
-        m_window->Update();
+    const std::chrono::duration<double, std::milli> elapsed {std::chrono::steady_clock::now() - start};
+    const auto& stats {GetRenderStats()};
+    std::println("{} frames at {}x{}: {:.2f} ms, {:.3f} ms/frame, {} draw calls/frame", m_specification.frameCount, width, height,
+                 elapsed.count(), elapsed.count() / std::max<std::uint32_t>(m_specification.frameCount, 1), stats.drawCalls);
+}
+
+/*
+ * True while any layer changes on its own or textures are still loading.
+ */
+bool Game::NeedsRedraw() const
+{
+    if (Renderer::TextureLoader::Instance().GetPendingCount() > 0)
+    {
+        return true;
     }
+
+    for (const auto& layer: m_layerStack)
+    {
+        if (layer->NeedsRedraw())
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
+/*
+ * Layers submit draw commands in stack order, each layer on its own queue layer, then the whole
+ * frame is sorted and drawn at once. Components cull against the camera's view while submitting.
+ * The colour clear is skipped when an opaque command, ex. the ocean, covers the whole view anyway.
+ */
 void Game::Render()
 {
+    m_renderQueue.Begin(m_camera->GetViewRect());
+
+    std::uint8_t layerIndex {0};
     for (auto& layer: m_layerStack)
     {
-        layer->OnRender();
+        m_renderQueue.SetLayer(layerIndex++);
+        layer->OnRender(m_renderQueue);
     }
+
+    ClearFrame(!m_renderQueue.CoversView());
+    m_renderQueue.Execute();
+    AccumulateOverdraw();
+
+    // Debug lines recorded while submitting, drawn over the scene.
+    Renderer::DebugDraw::Flush();
 }
 
 void Game::Update(float deltaTime)
@@ -103,6 +350,17 @@ void Game::Update(float deltaTime)
  */
 void Game::RaiseEvent(Event::Event &event)
 {
+    // Input and window events may change what is on screen.
+    m_redraw = true;
+
+    Event::EventDispatcher dispatcher(event);
+    dispatcher.Dispatch<Event::WindowResizedEvent>([this](Event::WindowResizedEvent& e){return OnWindowResized(e);});
+    dispatcher.Dispatch<Event::KeyPressedEvent>([this](Event::KeyPressedEvent& e){return OnKeyPressed(e);});
+    if (event.isHandled)
+    {
+        return;
+    }
+
     for (auto iter = m_layerStack.rbegin(); iter != m_layerStack.rend(); ++iter)
     {
         (*iter)->OnEvent(event);
@@ -114,10 +372,118 @@ void Game::RaiseEvent(Event::Event &event)
 }
 
 /*
- * Used to provide access to Window management class when pushing layers onto stack.
+ * Resizes the viewport and camera once for every layer, event is left unhandled so layers may still react.
+ */
+bool Game::OnWindowResized(Event::WindowResizedEvent& event)
+{
+    const auto [width, height] = m_window->GetFrameBufferSize();
+    glViewport(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+    m_camera->SetViewport(width, height);
+
+    return false;
+}
+
+/*
+ * Keys handled by the application itself, before any layer sees them.
+ */
+bool Game::OnKeyPressed(Event::KeyPressedEvent& event)
+{
+    if (event.m_keyCode == k_DebugDrawKey && !event.IsRepeat())
+    {
+        Renderer::DebugDraw::SetEnabled(!Renderer::DebugDraw::IsEnabled());
+        return true;
+    }
+
+    if (event.m_keyCode == k_OverdrawKey && !event.IsRepeat())
+    {
+        const bool counting {m_renderQueue.IsCountingOverdraw()};
+        if (counting)
+        {
+            ReportOverdraw();
+        }
+        m_renderQueue.SetOverdrawCounting(!counting);
+        return true;
+    }
+    return false;
+}
+
+void Game::AccumulateOverdraw()
+{
+    const auto* overdraw {m_renderQueue.GetOverdraw()};
+    if (!overdraw)
+    {
+        return;
+    }
+
+    for (const auto& layer: overdraw->GetLayers())
+    {
+        auto& summary {m_overdrawLayers[layer.layer]};
+        summary.averageSum += layer.average;
+        summary.max         = std::max(summary.max, layer.max);
+    }
+
+    m_overdrawTotal.averageSum += overdraw->GetTotal().average;
+    m_overdrawTotal.max         = std::max(m_overdrawTotal.max, overdraw->GetTotal().max);
+    ++m_overdrawFrames;
+}
+
+/*
+ * Prints the average and worst overdraw of every layer over the frames counted since the last
+ * report, then starts over. Averages are fragments per pixel, 1.0 shades every pixel once.
+ */
+void Game::ReportOverdraw()
+{
+    if (m_overdrawFrames == 0)
+    {
+        return;
+    }
+
+    const auto frames {static_cast<double>(m_overdrawFrames)};
+    std::println("overdraw over {} frames:", m_overdrawFrames);
+    for (const auto& [layer, summary]: m_overdrawLayers)
+    {
+        std::println("  layer {}: average {:.2f} max {}", layer, summary.averageSum / frames, summary.max);
+    }
+    std::println("  total:   average {:.2f} max {}", m_overdrawTotal.averageSum / frames, m_overdrawTotal.max);
+
+    m_overdrawLayers.clear();
+    m_overdrawTotal  = {};
+    m_overdrawFrames = 0;
+}
+
+/*
+ * Used to provide access to Window management class when pushing layers onto stack, null headless.
  */
 std::shared_ptr<Window> Game::GetWindow() noexcept
 {
     return m_window;
 }
+
+std::shared_ptr<Renderer::CameraBuffer> Game::GetCamera() noexcept
+{
+    return m_camera;
+}
+
+const Renderer::RenderStats& Game::GetRenderStats() const noexcept
+{
+    return m_renderQueue.GetStats();
+}
+
+const FrameTimings& Game::GetFrameTimings() const noexcept
+{
+    return m_timings;
+}
+
+/*
+ * Components in the layer stack, layers and all their descendants.
+ */
+std::size_t Game::GetComponentCount() const
+{
+    std::size_t count {0};
+    for (const auto& layer: m_layerStack)
+    {
+        count += CountComponents(*layer);
+    }
+    return count;
+}
 }// namespace Core
@@ -2,15 +2,31 @@
 #define GAME_H
 
 #include <concepts>
+#include <cstdint>
+#include <filesystem>
 #include <list>
+#include <map>
 #include <memory>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
 #include "events/Events.h"
+#include "events/WindowEvents.h"
+#include "events/KeyEvents.h"
 #include "core/world.h"
 #include "core/window.h"
+#include "core/HeadlessContext.h"
+
+#include "renderer/CameraBuffer.h"
+#include "renderer/FrameCapture.h"
+#include "renderer/Framebuffer.h"
+#include "renderer/RenderQueue.h"
+
+// Where the gamenine-assets target cooks textures, set by the build.
+#ifndef GAMENINE_COOKED_DIRECTORY
+#define GAMENINE_COOKED_DIRECTORY "build/cooked"
+#endif
 
 namespace Core
 {
@@ -18,6 +34,35 @@ struct ApplicationSpecification
 {
     std::string name = "Application";
     WindowSpecification windowspec = WindowSpecification();
+
+    // Mounted when present, resources missing from it are read from loose files.
+    std::filesystem::path resourcePack = "resources.g9pack";
+
+    // Cooked '.g9tex' files are looked up here, see Renderer::Texture2D::PreferCooked().
+    std::filesystem::path cookedDirectory = GAMENINE_COOKED_DIRECTORY;
+
+    // Sleep until input arrives and only draw frames when something changed, see Game::Run().
+    bool renderOnDemand = false;
+
+    // Render through an EGL context into an offscreen framebuffer, no window or display needed.
+    bool headless = false;
+
+    // Headless only: frames drawn before Run() returns, each simulated with a fixed time step.
+    std::uint32_t frameCount = 600;
+
+    // Headless only: when set, every frame is read back asynchronously and saved here as a .ppm.
+    std::filesystem::path captureDirectory;
+
+    // Start with overdraw counting on, frames show a heatmap, see Renderer::OverdrawCounter.
+    bool overdraw = false;
+};
+
+// CPU time of the last frame's stages in milliseconds, measured by Game::Run().
+struct FrameTimings
+{
+    float frame  {0.0f}; // since the previous frame started.
+    float update {0.0f}; // layers, camera and texture uploads.
+    float render {0.0f}; // submitting, sorting and issuing draw calls, without the buffer swap.
 };
 
 // Application.
@@ -28,8 +73,42 @@ private:
     ApplicationSpecification m_specification;
     std::shared_ptr<Window>  m_window;
 
+    // Headless replacements for the window, its context and its default framebuffer.
+    std::unique_ptr<HeadlessContext> m_headless;
+    std::unique_ptr<Renderer::Framebuffer> m_framebuffer;
+    std::unique_ptr<Renderer::FrameCapture> m_capture;
+
+    // Shared by every layer through the 'Camera' uniform block.
+    std::shared_ptr<Renderer::CameraBuffer> m_camera;
+
+    // Draw commands submitted by every layer, sorted and executed once per frame.
+    Renderer::RenderQueue m_renderQueue;
+
     std::list<std::unique_ptr<World::WorldComponent>> m_layerStack;
 
+    // On-demand rendering: set by events and by layers that report NeedsRedraw().
+    bool m_redraw;
+
+    FrameTimings m_timings;
+
+    // Overdraw of every frame counted so far, by queue layer; reported and reset by ReportOverdraw().
+    struct OverdrawSummary
+    {
+        double averageSum {0.0};
+        std::uint32_t max {0};
+    };
+    std::map<std::uint8_t, OverdrawSummary> m_overdrawLayers;
+    OverdrawSummary m_overdrawTotal;
+    std::uint64_t m_overdrawFrames;
+
+    void AccumulateOverdraw();
+    void ReportOverdraw();
+
+    bool NeedsRedraw() const;
+    void RunHeadless();
+    bool OnWindowResized(Event::WindowResizedEvent& event);
+    bool OnKeyPressed(Event::KeyPressedEvent& event);
+
 public:
 
     Game(const ApplicationSpecification& specification = ApplicationSpecification());
@@ -42,8 +121,13 @@ public:
     void Update(float deltaTime);
     void RaiseEvent(Event::Event &event);
 
+    const Renderer::RenderStats& GetRenderStats() const noexcept;
+    const FrameTimings& GetFrameTimings() const noexcept;
+    std::size_t GetComponentCount() const;
+
     // Share window specification with layers.
     std::shared_ptr<Window> GetWindow() noexcept;
+    std::shared_ptr<Renderer::CameraBuffer> GetCamera() noexcept;
 
     template<typename TLayer, typename ...Args>
     requires(std::derived_from<TLayer, World::WorldComponent>)
@@ -0,0 +1,189 @@
+#include "game/PerformanceOverlay.h"
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <string_view>
+
+#include "game/Game.h"
+#include "managers/ResourceManager.h"
+
+namespace Core
+{
+namespace
+{
+    // Texture unit of the font atlas while the overlay draws.
+    constexpr GLint k_FontIndex {0};
+
+    constexpr float k_TextScale {2.0f};
+    constexpr float k_LineHeight {Renderer::BitmapFont::k_GlyphSize * k_TextScale + 2.0f};
+    constexpr glm::vec2 k_Origin {8.0f, 8.0f};
+    constexpr float k_Padding {6.0f};
+
+    constexpr glm::vec2 k_GraphSize {PerformanceOverlay::k_HistorySize * 2.0f, 64.0f};
+    constexpr float k_GraphRange {50.0f}; // milliseconds at the top of the graph.
+
+    constexpr std::uint32_t k_Background {Renderer::PackColor(0, 0, 0, 176)};
+    constexpr std::uint32_t k_TextColor  {Renderer::PackColor(255, 255, 255)};
+    constexpr std::uint32_t k_Good       {Renderer::PackColor(64, 220, 96)};
+    constexpr std::uint32_t k_Slow       {Renderer::PackColor(240, 200, 48)};
+    constexpr std::uint32_t k_Bad        {Renderer::PackColor(230, 64, 64)};
+    constexpr std::uint32_t k_Guide      {Renderer::PackColor(255, 255, 255, 96)};
+
+    constexpr float k_TargetMs {1000.0f / 60.0f};
+
+    std::uint32_t FrameColor(float milliseconds) noexcept
+    {
+        if (milliseconds <= k_TargetMs + 0.5f)
+        {
+            return k_Good;
+        }
+        return milliseconds <= 2.0f * k_TargetMs ? k_Slow : k_Bad;
+    }
+}// anonymous namespace
+
+PerformanceOverlay::PerformanceOverlay(Game& game, bool visible, std::string name):
+World::WorldComponent(World::GenerateComponentId(), std::move(name)),
+m_game(game),
+m_camera(game.GetCamera()),
+m_batch(k_FontIndex),
+m_frameTimes{},
+m_head(0),
+m_visible(visible)
+{
+    m_text.reserve(512);
+}
+
+void PerformanceOverlay::OnEvent(Event::Event& event)
+{
+    Event::EventDispatcher dispatcher(event);
+    dispatcher.Dispatch<Event::KeyPressedEvent>([this](Event::KeyPressedEvent& e){return OnKeyPressed(e);});
+}
+
+bool PerformanceOverlay::OnKeyPressed(const Event::KeyPressedEvent& e)
+{
+    if (e.m_keyCode != k_ToggleKey || e.IsRepeat())
+    {
+        return false;
+    }
+
+    m_visible = !m_visible;
+    return true;
+}
+
+/*
+* Records the last frame and rebuilds the overlay's quads. Counters are the previous frame's, the
+* current one has not been rendered yet.
+*/
+void PerformanceOverlay::OnUpdate(float deltaSeconds)
+{
+    const auto& timings {m_game.GetFrameTimings()};
+    m_frameTimes[m_head] = timings.frame;
+    m_head = (m_head + 1) % k_HistorySize;
+
+    m_batch.BeginFrame();
+    if (!m_visible)
+    {
+        return;
+    }
+
+    const auto& stats {m_game.GetRenderStats()};
+    const float slowest {std::ranges::max(m_frameTimes)};
+    const float textureMB {static_cast<float>(Manager::ResourceManager::Instance().GetTextureBytes()) / (1024.0f * 1024.0f)};
+
+    m_text.clear();
+    std::format_to(std::back_inserter(m_text), "{:5.1f} fps {:6.2f} ms max {:.2f}\n",
+                   timings.frame > 0.0f ? 1000.0f / timings.frame : 0.0f, timings.frame, slowest);
+    std::format_to(std::back_inserter(m_text), "update {:.2f} ms render {:.2f} ms\n", timings.update, timings.render);
+    std::format_to(std::back_inserter(m_text), "draws {} commands {}\n", stats.drawCalls, stats.commands);
+    std::format_to(std::back_inserter(m_text), "binds shader {} texture {} vao {}\n", stats.shaderChanges, stats.textureChanges, stats.vertexArrayChanges);
+    std::format_to(std::back_inserter(m_text), "visible {} culled {} occluded {}\n", stats.visible, stats.culled, stats.occluded);
+    std::format_to(std::back_inserter(m_text), "components {} textures {:.1f} MB", m_game.GetComponentCount(), textureMB);
+
+    // Panel first, quads are drawn in the order they were added.
+    std::size_t lines {1};
+    std::size_t longest {0};
+    for (std::size_t start {0}; start < m_text.size();)
+    {
+        const auto end {std::min(m_text.find('\n', start), m_text.size())};
+        longest = std::max(longest, end - start);
+        lines  += end < m_text.size();
+        start   = end + 1;
+    }
+
+    const float textWidth {static_cast<float>(longest) * Renderer::BitmapFont::k_GlyphSize * k_TextScale};
+    const float textHeight {static_cast<float>(lines) * k_LineHeight};
+    const glm::vec2 panel {std::max(textWidth, k_GraphSize.x) + 2.0f * k_Padding, textHeight + k_GraphSize.y + 3.0f * k_Padding};
+
+    m_batch.AddRect(k_Origin, panel, k_Background);
+
+    // AddText() advances one glyph per line, lay lines out with some spacing instead.
+    glm::vec2 pen {k_Origin + k_Padding};
+    for (std::size_t start {0}; start < m_text.size();)
+    {
+        const auto end {std::min(m_text.find('\n', start), m_text.size())};
+        m_batch.AddText(pen, std::string_view{m_text}.substr(start, end - start), k_TextColor, k_TextScale);
+        pen.y += k_LineHeight;
+        start  = end + 1;
+    }
+
+    DrawGraph({k_Origin.x + k_Padding, pen.y + k_Padding}, k_GraphSize);
+
+    m_batch.Upload(m_camera->GetViewport());
+}
+
+/*
+* One bar per recorded frame, oldest on the left, with guides at 60 and 30 frames per second.
+*/
+void PerformanceOverlay::DrawGraph(glm::vec2 topLeft, glm::vec2 size)
+{
+    const float barWidth {size.x / static_cast<float>(k_HistorySize)};
+    const float bottom {topLeft.y + size.y};
+
+    for (std::size_t i {0}; i < k_HistorySize; ++i)
+    {
+        const float milliseconds {m_frameTimes[(m_head + i) % k_HistorySize]};
+        const float height {std::min(milliseconds / k_GraphRange, 1.0f) * size.y};
+        if (height > 0.0f)
+        {
+            m_batch.AddRect({topLeft.x + static_cast<float>(i) * barWidth, bottom - height}, {barWidth, height}, FrameColor(milliseconds));
+        }
+    }
+
+    for (const float guide: {k_TargetMs, 2.0f * k_TargetMs})
+    {
+        m_batch.AddRect({topLeft.x, bottom - guide / k_GraphRange * size.y}, {size.x, 1.0f}, k_Guide);
+    }
+}
+
+void PerformanceOverlay::OnRender(Renderer::RenderQueue& queue) const
+{
+    if (m_visible && !m_batch.IsEmpty())
+    {
+        queue.Submit(m_batch.GetCommand(), 0.0f, true);
+    }
+}
+
+/*
+* The graph scrolls every frame while shown.
+*/
+bool PerformanceOverlay::NeedsRedraw() const
+{
+    return m_visible;
+}
+
+glm::vec3 PerformanceOverlay::GetPosition() const noexcept
+{
+    return glm::vec3{0.0f};
+}
+
+void PerformanceOverlay::SetVisible(bool visible) noexcept
+{
+    m_visible = visible;
+}
+
+bool PerformanceOverlay::IsVisible() const noexcept
+{
+    return m_visible;
+}
+}// namespace Core
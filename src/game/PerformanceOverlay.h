@@ -0,0 +1,65 @@
+#ifndef PERFORMANCEOVERLAY_H
+#define PERFORMANCEOVERLAY_H
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <GLFW/glfw3.h>
+
+#include "core/world.h"
+#include "events/KeyEvents.h"
+#include "renderer/CameraBuffer.h"
+#include "renderer/OverlayBatch.h"
+#include "renderer/RenderQueue.h"
+
+namespace Core
+{
+class Game;
+
+/*
+* Debug layer showing frame time, the time spent updating and rendering, the render queue's
+* counters, the number of components and texture memory, with a rolling graph of recent frame
+* times. Everything is drawn in one call through an OverlayBatch. Push it last so it draws over
+* every other layer; k_ToggleKey shows and hides it.
+*/
+class PerformanceOverlay final: public World::WorldComponent
+{
+public:
+
+    static constexpr int k_ToggleKey {GLFW_KEY_F3};
+    static constexpr std::size_t k_HistorySize {120};
+
+private:
+
+    const Game& m_game;
+    std::shared_ptr<Renderer::CameraBuffer> m_camera;
+
+    Renderer::OverlayBatch m_batch;
+
+    std::array<float, k_HistorySize> m_frameTimes; // milliseconds, ring buffer.
+    std::size_t m_head;                             // oldest sample, next to overwrite.
+
+    std::string m_text;
+    bool m_visible;
+
+    bool OnKeyPressed(const Event::KeyPressedEvent& e);
+    void DrawGraph(glm::vec2 topLeft, glm::vec2 size);
+
+public:
+
+    explicit PerformanceOverlay(Game& game, bool visible = false, std::string name = "PerformanceOverlay");
+
+    void OnEvent(Event::Event& event) override;
+    void OnUpdate(float deltaSeconds) override;
+    void OnRender(Renderer::RenderQueue& queue) const override;
+    bool NeedsRedraw() const override;
+
+    glm::vec3 GetPosition() const noexcept override;
+
+    void SetVisible(bool visible) noexcept;
+    bool IsVisible() const noexcept;
+};
+}// namespace Core
+
+#endif
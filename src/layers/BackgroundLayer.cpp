@@ -3,7 +3,6 @@
 #include <algorithm>
 #include <cassert>
 
-#include <glm/ext/matrix_clip_space.hpp>
 #include <glm/matrix.hpp>
 #include <GLFW/glfw3.h>
 
@@ -24,15 +23,14 @@ m_window(window)
 
     const std::string_view backgroundTexture{"resources/images/background.png"};
 
-    auto shader = m_resourceManager.LoadShader(vertexShader, fragmentShader, idName);
-    auto texture = m_resourceManager.LoadTexture(backgroundTexture, idName, 0);
+    auto& resources {Manager::ResourceManager::Instance()};
+    auto shader = resources.LoadShader(vertexShader, fragmentShader, idName);
+    auto texture = resources.LoadTexture(backgroundTexture, idName, 0);
 
     shader->Bind();
     shader->SetUniform1i("u_image", 0);
 
     m_background = std::make_unique<Manager::SceneHandler>(shader, m_window, texture);
-
-    this->UpdateProjection();
 }
 
 void BackgroundLayer::OnRender()
@@ -72,21 +70,6 @@ bool BackgroundLayer::mouseAABB(const glm::vec2& mousePosition, const glm::vec2&
     return collisionX && collisionY;
 }
 
-/*
- * On window resize, update projection.
- */
-void BackgroundLayer::UpdateProjection()
-{
-    if (!m_background)
-    {
-        return;
-    }
-
-    const auto [width, height] = m_window->GetFrameBufferSize();
-
-    m_background->SetProjection(glm::ortho(0.0f, width, 0.0f, height, -1.0f, 1.0f));
-}
-
 bool BackgroundLayer::OnMouseButtonPressed(Event::MouseButtonPressedEvent& event)
 {
     if (event.GetMouseButton() != GLFW_MOUSE_BUTTON_LEFT)
@@ -25,14 +25,11 @@ struct DragState
 class BackgroundLayer: public Layer::Layer
 {
 private:
-    Manager::ResourceManager m_resourceManager;
-
     std::unique_ptr<Manager::SceneHandler> m_background;
     std::shared_ptr<Core::Window> m_window;
     DragState m_dragstate;
 
     bool mouseAABB(const glm::vec2& mousePosition, const glm::vec2& visibleMin, const glm::vec2& visibleMax);
-    void UpdateProjection();
 
 public:
     BackgroundLayer(std::shared_ptr<Core::Window> window);
@@ -1,12 +1,58 @@
 #include "game/Game.h"
+#include "game/PerformanceOverlay.h"
+
+#include <charconv>
+#include <string_view>
 
 #include "scene/OceanMap.h"
 
-int main()
+/*
+ * Options:
+ *   --headless [frames]   render offscreen through EGL and exit, prints the average frame time.
+ *   --capture <directory> with --headless, save every frame as a .ppm.
+ *   --overdraw            draw the overdraw heatmap from the start and print per-layer counts.
+ *   --pack <file>         mount this resource pack instead of 'resources.g9pack'.
+ *   --on-demand           sleep until input arrives and only draw frames when something changed.
+ */
+int main(int argc, char* argv[])
 {
     Core::ApplicationSpecification appspec{"Game9"};
+    for (int i {1}; i < argc; ++i)
+    {
+        const std::string_view argument {argv[i]};
+        if (argument == "--headless")
+        {
+            appspec.headless = true;
+            if (i + 1 < argc)
+            {
+                const std::string_view count {argv[i + 1]};
+                if (std::from_chars(count.data(), count.data() + count.size(), appspec.frameCount).ec == std::errc{})
+                {
+                    ++i;
+                }
+            }
+        }
+        else if (argument == "--capture" && i + 1 < argc)
+        {
+            appspec.captureDirectory = argv[++i];
+        }
+        else if (argument == "--overdraw")
+        {
+            appspec.overdraw = true;
+        }
+        else if (argument == "--pack" && i + 1 < argc)
+        {
+            appspec.resourcePack = argv[++i];
+        }
+        else if (argument == "--on-demand")
+        {
+            appspec.renderOnDemand = true;
+        }
+    }
+
     Core::Game application(appspec);
-    application.PushLayer<OceanMap::OceanMapComposite>();
+    application.PushLayer<OceanMap::OceanMapComposite>(application.GetCamera());
+    application.PushLayer<Core::PerformanceOverlay>(application);
     application.Run();
 
     return EXIT_SUCCESS;
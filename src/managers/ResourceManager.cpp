@@ -2,89 +2,263 @@
 
 #include <exception>
 #include <cstdio>
+#include <format>
 #include <print>
 
 #include <filesystem>
+#include <string>
 #include <string_view>
+#include <system_error>
 
 #include <stb_image.h>
 
+#include "utility/Hash.h"
+#include "utility/ResourcePack.h"
+
 namespace Manager
 {
+namespace
+{
+    /*
+    * Same key for every spelling of a path: "./a/../b.png" and "b.png" match. Paths only found in
+    * the resource pack can not be resolved on disk and use the pack's key.
+    */
+    std::string CanonicalKey(const std::filesystem::path& path)
+    {
+        std::error_code error;
+        if (std::filesystem::exists(path, error))
+        {
+            if (auto canonical {std::filesystem::weakly_canonical(path, error)}; !error)
+            {
+                return canonical.generic_string();
+            }
+        }
+        return Utility::ResourceKey(path);
+    }
 
-/**************** ShaderFileHandler ************************/
+    std::string ContentKey(std::string_view contents)
+    {
+        return std::format("{:016x}", Utility::Fnv1a64(contents));
+    }
+}// anonymous namespace
 
-// explicit prevents implicit conversion of uid to a ShaderFileHandler.
-// ex. SomeFunc(1) -> SomeFunc(ShaderFileHandler).
-ResourceManager::ShaderFileHandler::ShaderFileHandler(unsigned int id):
-ID(id)
+ResourceManager::ResourceManager(std::size_t textureBudget):
+m_shaders(),
+m_textures([](const Renderer::Texture2D& texture) {return texture.GetByteSize();}, textureBudget)
 {}
 
-ResourceManager::ShaderFileHandler::~ShaderFileHandler()
+ResourceManager& ResourceManager::Instance()
 {
-    if (ID) glDeleteShader(ID);
+    static ResourceManager manager(k_DefaultTextureBudget);
+    return manager;
 }
 
-// Move constructor.
-ResourceManager::ShaderFileHandler::ShaderFileHandler(ShaderFileHandler&& other) noexcept:
-ID(other.ID)
+/*
+ * Returns a handle to the shader program built from the two files, compiled once and shared by
+ * every caller. Stages already compiled for another shader are reused from Renderer::ShaderCache.
+ * Release() the handle when done with it.
+*/
+ShaderHandle ResourceManager::AcquireShader(const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath)
 {
-    other.ID = 0;
+    std::scoped_lock lock(m_mutex);
+    return AcquireShaderLocked(vertexPath, fragmentPath);
 }
 
-// Move Assignment: Delete own ID and copy other's ID.
-ResourceManager::ShaderFileHandler& ResourceManager::ShaderFileHandler::operator=(ShaderFileHandler&& other) noexcept
+/*
+ * Looks the pair up by path, then by the hash of both sources so copies of the same shader under
+ * other names share one program.
+ */
+ShaderHandle ResourceManager::AcquireShaderLocked(const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath)
 {
-    if (this != &other)
+    const auto pathKey {CanonicalKey(vertexPath) + '|' + CanonicalKey(fragmentPath)};
+    if (const auto handle {m_shaders.Find(pathKey)}; handle.IsValid())
+    {
+        ++m_stats.hits;
+        return handle;
+    }
+    ++m_stats.misses;
+
+    const auto vertex {Utility::ReadResource(vertexPath)};
+    const auto fragment {Utility::ReadResource(fragmentPath)};
+    if (!vertex || !fragment)
+    {
+        std::println(stderr, "{}", !vertex ? vertex.error() : fragment.error());
+        return {};
+    }
+
+    const auto contentKey {ContentKey(vertex->GetText()) + '|' + ContentKey(fragment->GetText())};
+    if (const auto handle {m_shaders.Find(contentKey)}; handle.IsValid())
     {
-        if (ID) glDeleteShader(ID);
-        ID = other.ID;
-        other.ID = 0;
+        ++m_stats.deduplicated;
+        m_shaders.Alias(pathKey, handle);
+        return handle;
     }
-    return *this;
+
+    const auto handle {m_shaders.Acquire(contentKey, [vertexPath, fragmentPath]() -> std::shared_ptr<Renderer::Shader>
+    {
+        try
+        {
+            return std::make_shared<Renderer::Shader>(vertexPath, fragmentPath);
+        }
+        catch (const std::exception& e)
+        {
+            std::println(stderr, "Failed to create shader '{}': {}", vertexPath.string(), e.what());
+            return nullptr;
+        }
+    })};
+
+    m_shaders.Alias(pathKey, handle);
+    return handle;
 }
 
-/**************** ShaderFileHandler ************************/
+/*
+ * Returns a handle to the texture at {texturePath} bound to {textureSlot}, loaded once and shared
+ * by every caller. Release() the handle when done with it, the texture may then be evicted.
+ */
+Texture2DHandle ResourceManager::AcquireTexture(const std::filesystem::path& texturePath, const int textureSlot)
+{
+    std::scoped_lock lock(m_mutex);
+    return AcquireTextureLocked(texturePath, textureSlot);
+}
 
 /*
- * Parses and compiles vertex and fragment shader files. If shader path already exist,
- * create a new shader and attach the already created shader id to a new program.
-*/
-std::shared_ptr<Renderer::Shader> ResourceManager::LoadShader(const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath, const std::string_view shaderName)
+ * Looks the texture up by path, then by the hash of the file so the same image under another name
+ * is uploaded once.
+ */
+Texture2DHandle ResourceManager::AcquireTextureLocked(const std::filesystem::path& texturePath, const int textureSlot)
 {
-    if (!std::filesystem::exists(vertexPath))
+    const auto slot {std::format("#{}", textureSlot)};
+
+    const auto pathKey {CanonicalKey(texturePath) + slot};
+    if (const auto handle {m_textures.Find(pathKey)}; handle.IsValid())
     {
-        std::println(stderr, "Shader path '{}' not found.", vertexPath.string());
-        return nullptr;
+        ++m_stats.hits;
+        return handle;
     }
-    else if (!std::filesystem::exists(fragmentPath))
+    ++m_stats.misses;
+
+    const auto contents {Utility::ReadResource(texturePath)};
+    if (!contents)
     {
-        std::println(stderr, "Shader path '{}' not found.", fragmentPath.string());
-        return nullptr;
+        std::println(stderr, "Texture path '{}' not found.", texturePath.string());
+        return {};
     }
-    else if (auto shaderIter = m_shader.find(shaderName); shaderIter != m_shader.end())
+
+    const auto contentKey {ContentKey(contents->GetText()) + slot};
+    if (const auto handle {m_textures.Find(contentKey)}; handle.IsValid())
     {
-        std::println(stderr, "Shader already exist with this name: {}", shaderName);
-        return nullptr;
+        ++m_stats.deduplicated;
+        m_textures.Alias(pathKey, handle);
+        return handle;
     }
 
-    try
+    const auto handle {m_textures.Acquire(contentKey, [texturePath, textureSlot]() -> std::shared_ptr<Renderer::Texture2D>
     {
-        // Create Shader.
-        auto shader = std::make_shared<Renderer::Shader>(vertexPath, fragmentPath);
-        m_shader.emplace(std::string{shaderName}, shader);
+        try
+        {
+            return std::make_shared<Renderer::Texture2D>(texturePath, textureSlot);
+        }
+        catch (const std::exception& e)
+        {
+            std::println(stderr, "Failed to create texture '{}': {}", texturePath.string(), e.what());
+            return nullptr;
+        }
+    })};
+
+    m_textures.Alias(pathKey, handle);
+    return handle;
+}
+
+void ResourceManager::Release(ShaderHandle handle)
+{
+    std::scoped_lock lock(m_mutex);
+    m_shaders.Release(handle);
+}
+
+void ResourceManager::Release(Texture2DHandle handle)
+{
+    std::scoped_lock lock(m_mutex);
+    m_textures.Release(handle);
+}
+
+/*
+ * Returns the shader behind {handle}, nullptr for an invalid handle.
+ */
+std::shared_ptr<Renderer::Shader> ResourceManager::Resolve(ShaderHandle handle)
+{
+    std::scoped_lock lock(m_mutex);
+    return m_shaders.Resolve(handle);
+}
 
-        return shader;
+/*
+ * Returns the texture behind {handle}, reloading it if it was evicted. Holding the returned
+ * pointer keeps the texture resident.
+ */
+std::shared_ptr<Renderer::Texture2D> ResourceManager::Resolve(Texture2DHandle handle)
+{
+    std::scoped_lock lock(m_mutex);
+    return m_textures.Resolve(handle);
+}
+
+/*
+ * Caps GPU memory used by textures, evicting unreferenced ones right away if already over.
+ */
+void ResourceManager::SetTextureBudget(std::size_t bytes)
+{
+    std::scoped_lock lock(m_mutex);
+    m_textures.SetBudget(bytes);
+}
+
+std::size_t ResourceManager::GetTextureBytes() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_textures.GetResidentBytes();
+}
+
+ResourceStats ResourceManager::GetStats() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_stats;
+}
+
+/*
+ * Drops every resource and name, GPU objects must be released while the context is still alive.
+ */
+void ResourceManager::Clear()
+{
+    std::scoped_lock lock(m_mutex);
+    m_shaderNames.clear();
+    m_textureNames.clear();
+    m_asyncTextures.clear();
+    m_shaders.Clear();
+    m_textures.Clear();
+}
+
+/*
+ * Parses and compiles vertex and fragment shader files under {shaderName}. Loading a name again
+ * returns the shader already loaded under it.
+*/
+std::shared_ptr<Renderer::Shader> ResourceManager::LoadShader(const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath, const std::string_view shaderName)
+{
+    std::scoped_lock lock(m_mutex);
+    if (auto iter = m_shaderNames.find(shaderName); iter != m_shaderNames.end())
+    {
+        return m_shaders.Resolve(iter->second);
     }
-    catch (const std::exception& e)
+
+    const auto handle {AcquireShaderLocked(vertexPath, fragmentPath)};
+    if (!handle.IsValid())
     {
-        std::println(stderr, "Failed to create shader '{}': {}", shaderName, e.what());
         return nullptr;
     }
+
+    m_shaderNames.emplace(std::string{shaderName}, handle);
+    return m_shaders.Resolve(handle);
 }
 
 /*
- * Creates a texture allowing shader to read texture data.
+ * Creates a texture allowing shader to read texture data. Loading a name again returns the texture
+ * already loaded under it. The returned pointer keeps the texture resident while held.
  *
  * @params:
  * texturePath: absolute path to 2D texture (in this case .png file).
@@ -93,37 +267,52 @@ std::shared_ptr<Renderer::Shader> ResourceManager::LoadShader(const std::filesys
  */
 std::shared_ptr<Renderer::Texture2D> ResourceManager::LoadTexture(const std::filesystem::path& texturePath, const std::string_view textureName, const int textureSlot)
 {
-    if (!std::filesystem::exists(texturePath))
+    std::scoped_lock lock(m_mutex);
+    if (auto iter = m_textureNames.find(textureName); iter != m_textureNames.end())
     {
-        std::println(stderr, "Texture path '{}' not found.", texturePath.string());
-        return nullptr;
+        return m_textures.Resolve(iter->second);
     }
 
-    if (auto iter = m_textures.find(textureName); iter != m_textures.end())
+    const auto handle {AcquireTextureLocked(texturePath, textureSlot)};
+    if (!handle.IsValid())
     {
-        std::println(stderr, "Texture already exist with this name: {}", textureName);
         return nullptr;
     }
 
-    try
-    {
-        auto texture = std::make_shared<Renderer::Texture2D>(texturePath, textureSlot);
-        m_textures.emplace(std::string{textureName}, texture);
+    m_textureNames.emplace(std::string{textureName}, handle);
+    return m_textures.Resolve(handle);
+}
 
-        return texture;
+/*
+ * Same as LoadTexture() without blocking: decoding and upload happen through
+ * Renderer::TextureLoader and the handle draws a placeholder until the texture is ready.
+ */
+Renderer::TextureHandle ResourceManager::LoadTextureAsync(const std::filesystem::path& texturePath, const std::string_view textureName, const int textureSlot)
+{
+    std::scoped_lock lock(m_mutex);
+    if (auto iter = m_asyncTextures.find(textureName); iter != m_asyncTextures.end())
+    {
+        return iter->second;
     }
-    catch (const std::exception& e)
+
+    if (!Utility::ResourceExists(texturePath))
     {
-        std::println(stderr, "Failed to create texture '{}': {}", textureName, e.what());
+        std::println(stderr, "Texture path '{}' not found.", texturePath.string());
         return nullptr;
     }
+
+    auto texture = Renderer::TextureLoader::Instance().Load(texturePath, textureSlot);
+    m_asyncTextures.emplace(std::string{textureName}, texture);
+
+    return texture;
 }
 
 std::shared_ptr<Renderer::Shader> ResourceManager::GetShader(const std::string_view shaderName)
 {
-    if (auto iter = m_shader.find(shaderName); iter != m_shader.end())
+    std::scoped_lock lock(m_mutex);
+    if (auto iter = m_shaderNames.find(shaderName); iter != m_shaderNames.end())
     {
-        return iter->second;
+        return m_shaders.Resolve(iter->second);
     }
 
     return nullptr;
@@ -131,7 +320,19 @@ std::shared_ptr<Renderer::Shader> ResourceManager::GetShader(const std::string_v
 
 std::shared_ptr<Renderer::Texture2D> ResourceManager::GetTexture(const std::string_view textureName)
 {
-    if (auto iter = m_textures.find(textureName); iter != m_textures.end())
+    std::scoped_lock lock(m_mutex);
+    if (auto iter = m_textureNames.find(textureName); iter != m_textureNames.end())
+    {
+        return m_textures.Resolve(iter->second);
+    }
+
+    return nullptr;
+}
+
+Renderer::TextureHandle ResourceManager::GetTextureAsync(const std::string_view textureName)
+{
+    std::scoped_lock lock(m_mutex);
+    if (auto iter = m_asyncTextures.find(textureName); iter != m_asyncTextures.end())
     {
         return iter->second;
     }
@@ -150,13 +351,16 @@ std::shared_ptr<Renderer::Texture2D> ResourceManager::GetTexture(const std::stri
 */
 std::shared_ptr<unsigned char> ResourceManager::LoadImage(const std::string_view path, int& width, int& height)
 {
-    if (!std::filesystem::exists(path))
+    const auto resource {Utility::ReadResource(path)};
+    if (!resource)
     {
         std::println(stderr, "Image Path '{}' not found.", path);
         return nullptr;
     }
 
-    return std::shared_ptr<unsigned char>(stbi_load(path.data(), &width, &height, 0, 4), stbi_image_free);
+    const auto bytes {resource->GetBytes()};
+    return std::shared_ptr<unsigned char>(stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(bytes.data()),
+            static_cast<int>(bytes.size()), &width, &height, 0, 4), stbi_image_free);
 }
 
 }// namespace Manager
@@ -1,7 +1,10 @@
 #ifndef RESOURCEMANGER_H
 #define RESOURCEMANGER_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include <filesystem>
 #include <string>
@@ -9,48 +12,87 @@
 
 #include <GL/glew.h>
 
+#include "managers/ResourcePool.h"
 #include "renderer/Shader.h"
 #include "renderer/Texture2D.h"
+#include "renderer/TextureLoader.h"
 
 namespace Manager
 {
-// Loads and unloads resources. Keeps track of object ID's for shaders and textures.
+using ShaderHandle    = Handle<Renderer::Shader>;
+using Texture2DHandle = Handle<Renderer::Texture2D>;
+
+struct ResourceStats
+{
+    std::uint64_t hits         {0}; // found by path.
+    std::uint64_t misses       {0}; // path seen for the first time.
+    std::uint64_t deduplicated {0}; // misses whose contents were already loaded under another path.
+};
+
+/*
+* Process-wide resource service. Shaders and textures are cached by canonical path and by content
+* hash behind handles with reference counts, so identical files load once whatever they are
+* called. Textures nobody references are evicted least recently used first once the texture budget
+* is exceeded and reloaded when used again.
+*
+* Every call is thread-safe. A miss creates GPU objects, so it must come from the thread owning the
+* OpenGL context; other threads should load through Renderer::TextureLoader.
+*/
 class ResourceManager
 {
 private:
 
-    // RAII: Holds compiled shader file ID.
-    struct ShaderFileHandler
-    {
-        unsigned int ID;
+    static constexpr std::size_t k_DefaultTextureBudget {256 * 1024 * 1024};
 
-        explicit ShaderFileHandler(unsigned int id);
-        ~ShaderFileHandler();
+    mutable std::mutex m_mutex;
+    ResourceStats m_stats;
 
-        ShaderFileHandler(ShaderFileHandler&& other) noexcept;
-        ShaderFileHandler& operator=(ShaderFileHandler&& other) noexcept;
+    // Compiled shader stages are shared process-wide by Renderer::ShaderCache.
+    ResourcePool<Renderer::Shader> m_shaders;
+    ResourcePool<Renderer::Texture2D> m_textures;
 
-        ShaderFileHandler(const ShaderFileHandler&) = delete;
-        ShaderFileHandler& operator=(const ShaderFileHandler&) = delete;
-    };
+    // Names given to LoadShader() / LoadTexture(), each holds one reference for the manager's lifetime.
+    std::map<std::string, ShaderHandle, std::less<>> m_shaderNames;
+    std::map<std::string, Texture2DHandle, std::less<>> m_textureNames;
+    std::map<std::string, Renderer::TextureHandle, std::less<>> m_asyncTextures;
 
-    // std::string_view file path, ShaderFileHandler is from compileshader.
-    std::map<std::string, ShaderFileHandler, std::less<>> m_files;
+    explicit ResourceManager(std::size_t textureBudget);
 
-    // shader object should be transformed to open function instead of class functions ??
-    std::map<std::string, std::shared_ptr<Renderer::Shader>, std::less<>> m_shader;
-    std::map<std::string, std::shared_ptr<Renderer::Texture2D>, std::less<>> m_textures;
+    ShaderHandle AcquireShaderLocked(const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath);
+    Texture2DHandle AcquireTextureLocked(const std::filesystem::path& texturePath, const int textureSlot);
 
 public:
 
+    static ResourceManager& Instance();
+
+    ResourceManager(const ResourceManager&)            = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
+
+    ShaderHandle AcquireShader(const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath);
+    Texture2DHandle AcquireTexture(const std::filesystem::path& texturePath, const int textureSlot);
+
+    void Release(ShaderHandle handle);
+    void Release(Texture2DHandle handle);
+
+    std::shared_ptr<Renderer::Shader> Resolve(ShaderHandle handle);
+    std::shared_ptr<Renderer::Texture2D> Resolve(Texture2DHandle handle);
+
+    void SetTextureBudget(std::size_t bytes);
+    std::size_t GetTextureBytes() const;
+    ResourceStats GetStats() const;
+
+    void Clear();
+
     std::shared_ptr<Renderer::Shader> LoadShader(const std::filesystem::path& vertexPath, const std::filesystem::path& fragmentPath, const std::string_view shaderName);
     std::shared_ptr<Renderer::Shader> GetShader(const std::string_view shaderName);
 
     std::shared_ptr<Renderer::Texture2D> LoadTexture(const std::filesystem::path& texturePath, const std::string_view textureName, const int textureSlot);
     std::shared_ptr<Renderer::Texture2D> GetTexture(const std::string_view textureName);
 
-    std::shared_ptr<unsigned char> LoadImage(const std::string_view path, int& width, int& height);
+    Renderer::TextureHandle LoadTextureAsync(const std::filesystem::path& texturePath, const std::string_view textureName, const int textureSlot);
+    Renderer::TextureHandle GetTextureAsync(const std::string_view textureName);
 
+    std::shared_ptr<unsigned char> LoadImage(const std::string_view path, int& width, int& height);
 };
 }// namespace Manager
 #endif
@@ -0,0 +1,253 @@
+#ifndef RESOURCEPOOL_H
+#define RESOURCEPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "utility/Hash.h"
+
+namespace Manager
+{
+// Index into a ResourcePool<T>, typed so a shader handle can not be passed where a texture is expected.
+template<typename T>
+struct Handle
+{
+    static constexpr std::uint32_t k_Invalid {std::numeric_limits<std::uint32_t>::max()};
+
+    std::uint32_t index {k_Invalid};
+
+    bool IsValid() const noexcept {return index != k_Invalid;}
+    bool operator==(const Handle&) const = default;
+};
+
+/*
+* Resources keyed by path with explicit reference counts. An entry whose count drops to zero stays
+* resident as a cache; once the resident bytes exceed the budget, unreferenced entries are evicted
+* least recently used first. Evicted entries keep their slot and loader, so acquiring or resolving
+* them again reloads transparently. Not synchronized, ResourceManager guards it.
+*/
+template<typename T>
+class ResourcePool
+{
+public:
+
+    using Loader = std::function<std::shared_ptr<T>()>;
+    using Sizer  = std::function<std::size_t(const T&)>;
+
+private:
+
+    struct Slot
+    {
+        std::string key;
+        Loader load;
+        std::shared_ptr<T> resource; // null while evicted.
+        std::size_t byteSize {0};
+        std::uint32_t refCount {0};
+        std::uint64_t lastUse {0};
+    };
+
+    struct KeyHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view key) const noexcept {return static_cast<std::size_t>(Utility::Fnv1a64(key));}
+    };
+
+    std::vector<Slot> m_slots;
+    std::unordered_map<std::string, std::uint32_t, KeyHash, std::equal_to<>> m_index;
+
+    Sizer m_sizeOf;
+    std::size_t m_budget;
+    std::size_t m_residentBytes {0};
+    std::uint64_t m_clock {0};
+
+    /*
+    * A slot is evictable when no handle references it and no shared_ptr handed out still holds it.
+    */
+    bool IsEvictable(const Slot& slot) const noexcept
+    {
+        return slot.resource && slot.refCount == 0 && slot.resource.use_count() == 1;
+    }
+
+    bool Reload(Slot& slot)
+    {
+        slot.resource = slot.load();
+        if (!slot.resource)
+        {
+            return false;
+        }
+
+        slot.byteSize = m_sizeOf ? m_sizeOf(*slot.resource) : 0;
+        m_residentBytes += slot.byteSize;
+        return true;
+    }
+
+    void Evict(Slot& slot)
+    {
+        m_residentBytes -= slot.byteSize;
+        slot.byteSize = 0;
+        slot.resource.reset();
+    }
+
+    /*
+    * Evicts least recently used entries until under budget, never {keep}.
+    */
+    void Trim(std::uint32_t keep)
+    {
+        while (m_residentBytes > m_budget)
+        {
+            Slot* oldest {nullptr};
+            for (std::uint32_t i {0}; i < m_slots.size(); ++i)
+            {
+                if (i != keep && IsEvictable(m_slots[i]) && (!oldest || m_slots[i].lastUse < oldest->lastUse))
+                {
+                    oldest = &m_slots[i];
+                }
+            }
+
+            if (!oldest)
+            {
+                return;
+            }
+            Evict(*oldest);
+        }
+    }
+
+public:
+
+    explicit ResourcePool(Sizer sizeOf = {}, std::size_t budget = std::numeric_limits<std::size_t>::max()):
+    m_sizeOf(std::move(sizeOf)),
+    m_budget(budget)
+    {}
+
+    /*
+    * Returns the handle cached for {key} with one more reference, loading it through {load} the
+    * first time or after it was evicted. Returns an invalid handle if loading fails.
+    */
+    Handle<T> Acquire(std::string_view key, Loader load)
+    {
+        if (auto iter {m_index.find(key)}; iter != m_index.end())
+        {
+            auto& slot {m_slots[iter->second]};
+            if (!slot.resource && !Reload(slot))
+            {
+                return {};
+            }
+
+            ++slot.refCount;
+            slot.lastUse = ++m_clock;
+            Trim(iter->second);
+            return {iter->second};
+        }
+
+        const auto index {static_cast<std::uint32_t>(m_slots.size())};
+        Slot slot {.key = std::string{key}, .load = std::move(load)};
+        if (!Reload(slot))
+        {
+            return {};
+        }
+
+        slot.refCount = 1;
+        slot.lastUse  = ++m_clock;
+        m_slots.push_back(std::move(slot));
+        m_index.emplace(m_slots.back().key, index);
+
+        Trim(index);
+        return {index};
+    }
+
+    /*
+    * Returns the handle cached for {key} with one more reference, without loading anything.
+    */
+    Handle<T> Find(std::string_view key)
+    {
+        if (auto iter {m_index.find(key)}; iter != m_index.end())
+        {
+            return AddReference({iter->second});
+        }
+        return {};
+    }
+
+    /*
+    * Makes {key} another name for {handle}'s entry, so lookups by either find the same resource.
+    */
+    void Alias(std::string_view key, Handle<T> handle)
+    {
+        if (handle.IsValid() && handle.index < m_slots.size())
+        {
+            m_index.emplace(std::string{key}, handle.index);
+        }
+    }
+
+    Handle<T> AddReference(Handle<T> handle)
+    {
+        if (handle.IsValid() && handle.index < m_slots.size())
+        {
+            ++m_slots[handle.index].refCount;
+        }
+        return handle;
+    }
+
+    void Release(Handle<T> handle)
+    {
+        if (!handle.IsValid() || handle.index >= m_slots.size() || m_slots[handle.index].refCount == 0)
+        {
+            return;
+        }
+
+        if (--m_slots[handle.index].refCount == 0)
+        {
+            Trim(Handle<T>::k_Invalid);
+        }
+    }
+
+    /*
+    * Returns the resource, reloading it if it was evicted, and marks it as recently used. The
+    * shared_ptr keeps it resident for as long as it is held.
+    */
+    std::shared_ptr<T> Resolve(Handle<T> handle)
+    {
+        if (!handle.IsValid() || handle.index >= m_slots.size())
+        {
+            return nullptr;
+        }
+
+        auto& slot {m_slots[handle.index]};
+        if (!slot.resource && !Reload(slot))
+        {
+            return nullptr;
+        }
+
+        slot.lastUse = ++m_clock;
+        Trim(handle.index);
+        return slot.resource;
+    }
+
+    void SetBudget(std::size_t budget)
+    {
+        m_budget = budget;
+        Trim(Handle<T>::k_Invalid);
+    }
+
+    void Clear()
+    {
+        m_slots.clear();
+        m_index.clear();
+        m_residentBytes = 0;
+    }
+
+    std::size_t GetBudget() const noexcept {return m_budget;}
+    std::size_t GetResidentBytes() const noexcept {return m_residentBytes;}
+    std::uint32_t GetReferenceCount(Handle<T> handle) const noexcept
+    {
+        return handle.IsValid() && handle.index < m_slots.size() ? m_slots[handle.index].refCount : 0;
+    }
+};
+}// namespace Manager
+#endif
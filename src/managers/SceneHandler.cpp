@@ -20,12 +20,6 @@ void SceneHandler::SetPosition(const glm::vec2& position) noexcept
     m_model.position = position;
 }
 
-void SceneHandler::SetProjection(const glm::mat4& projection)
-{
-    assert(m_renderer && "Renderer must exist before setting projection.");
-    m_renderer->UpdateProjection(projection);
-}
-
 glm::vec2 SceneHandler::GetPosition() const noexcept
 {
     return m_model.position;
@@ -16,7 +16,7 @@ namespace Manager
 {
 /*
 * Handles drawing of the background / map. Handles drawing large images like the background
-* menu and such; unlike what other handlers that specialize in drawing the trains, etc.
+* menu and such; unlike handlers that specialize in drawing entities.
 */
 class SceneHandler
 {
@@ -31,7 +31,6 @@ public:
     SceneHandler(std::shared_ptr<Renderer::Shader> sceneshader, std::shared_ptr<Core::Window> window, std::shared_ptr<Renderer::Texture2D> texture);
 
     void SetPosition(const glm::vec2& position) noexcept;
-    void SetProjection(const glm::mat4& projection);
 
     glm::vec2 GetPosition() const noexcept;
     glm::vec2 GetScale() const noexcept;
@@ -0,0 +1,36 @@
+#ifndef AFFINE2D_H
+#define AFFINE2D_H
+
+#include <cmath>
+
+#include <glm/glm.hpp>
+
+namespace Renderer
+{
+/*
+* 2D affine transform, the top two rows of a 3x3 matrix: a point p maps to
+* {dot(x, {p, 1}), dot(y, {p, 1})}. Six floats instead of a 4x4 matrix's sixteen; shaders read it
+* as 'uniform vec3 u_Model[2]'.
+*/
+struct Affine2D
+{
+    glm::vec3 x {1.0f, 0.0f, 0.0f};
+    glm::vec3 y {0.0f, 1.0f, 0.0f};
+
+    // Scales then rotates by {rotation} radians counter-clockwise, then translates.
+    static Affine2D FromTransform(glm::vec2 position, glm::vec2 scale, float rotation) noexcept
+    {
+        const float cos {std::cos(rotation)};
+        const float sin {std::sin(rotation)};
+        return {{cos * scale.x, -sin * scale.y, position.x}, {sin * scale.x, cos * scale.y, position.y}};
+    }
+
+    // Unit square onto {rect} = {left, bottom, right, top}.
+    static Affine2D FromRect(const glm::vec4& rect) noexcept
+    {
+        return {{rect.z - rect.x, 0.0f, rect.x}, {0.0f, rect.w - rect.y, rect.y}};
+    }
+};
+static_assert(sizeof(Affine2D) == 6 * sizeof(float), "Affine2D is uploaded as two packed vec3.");
+}// namespace Renderer
+#endif
@@ -0,0 +1,42 @@
+#ifndef BITMAPFONT_H
+#define BITMAPFONT_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+namespace Renderer
+{
+/*
+* Built-in 8x8 monospace font for printable ASCII, compiled into the binary so debug text never
+* depends on assets. Glyphs are packed into one single-channel atlas of 16 by 6 cells; the cell of
+* DEL (127) is solid so plain rectangles can be drawn from the same texture as text.
+*/
+class BitmapFont
+{
+private:
+
+    GLuint m_texture;
+
+public:
+
+    static constexpr int k_GlyphSize {8};
+    static constexpr int k_Columns   {16};
+    static constexpr int k_Rows      {6};
+    static constexpr char k_FirstGlyph {' '};
+    static constexpr char k_SolidGlyph {127};
+
+    BitmapFont();
+    ~BitmapFont();
+
+    BitmapFont(const BitmapFont&)            = delete;
+    BitmapFont& operator=(const BitmapFont&) = delete;
+    BitmapFont(BitmapFont&&)                 = delete;
+    BitmapFont& operator=(BitmapFont&&)      = delete;
+
+    static glm::vec4 GetGlyphRect(char glyph) noexcept;
+    static glm::vec2 GetSolidTexel() noexcept;
+
+    GLuint GetTextureID() const noexcept;
+};
+}// namespace Renderer
+#endif
@@ -0,0 +1,109 @@
+#include "renderer/CameraBuffer.h"
+
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+namespace Renderer
+{
+/*
+* Allocates the uniform buffer and binds it to the camera binding point, the binding is
+* left in place for the lifetime of the buffer.
+*/
+CameraBuffer::CameraBuffer():
+m_UBO(0),
+m_block{glm::mat4(1.0f), glm::mat4(1.0f)},
+m_position(0.0f, 0.0f),
+m_viewport(1024.0f, 1024.0f),
+m_dirty(true)
+{
+    glGenBuffers(1, &m_UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, k_CameraBindingPoint, m_UBO);
+
+    Recalculate();
+}
+
+CameraBuffer::~CameraBuffer()
+{
+    if (m_UBO != 0)
+    {
+        glDeleteBuffers(1, &m_UBO);
+    }
+}
+
+/*
+* Orthographic projection covering the framebuffer, view looks down the -z axis at the camera position.
+*/
+void CameraBuffer::Recalculate()
+{
+    m_block.projection = glm::ortho(0.0f, m_viewport.x, 0.0f, m_viewport.y, -0.1f, 100.0f);
+    m_block.view = glm::lookAt
+        (
+         glm::vec3(m_position, 50.0f),
+         glm::vec3(m_position, 0.0f),
+         glm::vec3(0.0f, 1.0f, 0.0f)
+        );
+
+    m_dirty = true;
+}
+
+void CameraBuffer::SetViewport(float width, float height)
+{
+    m_viewport = {width, height};
+    Recalculate();
+}
+
+void CameraBuffer::SetPosition(const glm::vec2& position)
+{
+    if (position == m_position)
+    {
+        return;
+    }
+
+    m_position = position;
+    Recalculate();
+}
+
+glm::vec2 CameraBuffer::GetPosition() const noexcept
+{
+    return m_position;
+}
+
+glm::vec2 CameraBuffer::GetViewport() const noexcept
+{
+    return m_viewport;
+}
+
+/*
+* Returns the visible world rectangle as {left, bottom, right, top}.
+*/
+glm::vec4 CameraBuffer::GetViewRect() const noexcept
+{
+    return glm::vec4{m_position.x, m_position.y, m_position.x + m_viewport.x, m_position.y + m_viewport.y};
+}
+
+const CameraBlock& CameraBuffer::GetBlock() const noexcept
+{
+    return m_block;
+}
+
+/*
+* Pushes the camera block to the GPU, only when the camera has changed since the last upload.
+*/
+void CameraBuffer::Upload()
+{
+    if (!m_dirty)
+    {
+        return;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &m_block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    m_dirty = false;
+}
+}// namespace Renderer
@@ -0,0 +1,61 @@
+#ifndef CAMERABUFFER_H
+#define CAMERABUFFER_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+namespace Renderer
+{
+// Uniform block binding point every program reads 'Camera' from.
+constexpr GLuint k_CameraBindingPoint {0};
+
+// Mirrors the std140 'Camera' uniform block declared in the shaders.
+struct CameraBlock
+{
+    glm::mat4 view;
+    glm::mat4 projection;
+};
+static_assert(sizeof(CameraBlock) == 2 * sizeof(glm::mat4), "CameraBlock must match std140 layout.");
+
+/*
+* Owns the per-frame camera uniform buffer object. Shaders declare a 'Camera' uniform block
+* which Shader binds to k_CameraBindingPoint at link time; moving the camera or resizing the
+* window marks the block dirty and Upload() pushes it once for every program.
+*/
+class CameraBuffer
+{
+private:
+
+    GLuint m_UBO;
+    CameraBlock m_block;
+
+    glm::vec2 m_position; // bottom-left of the view in world space.
+    glm::vec2 m_viewport; // framebuffer width and height.
+
+    bool m_dirty;
+
+    void Recalculate();
+
+public:
+
+    CameraBuffer();
+    ~CameraBuffer();
+
+    CameraBuffer(const CameraBuffer&)            = delete;
+    CameraBuffer& operator=(const CameraBuffer&) = delete;
+    CameraBuffer(CameraBuffer&&)                 = delete;
+    CameraBuffer& operator=(CameraBuffer&&)      = delete;
+
+    void SetViewport(float width, float height);
+    void SetPosition(const glm::vec2& position);
+
+    glm::vec2 GetPosition() const noexcept;
+    glm::vec2 GetViewport() const noexcept;
+    glm::vec4 GetViewRect() const noexcept;
+
+    const CameraBlock& GetBlock() const noexcept;
+
+    void Upload();
+};
+}// namespace Renderer
+#endif
@@ -0,0 +1,14 @@
+#ifndef COLOR_H
+#define COLOR_H
+
+#include <cstdint>
+
+namespace Renderer
+{
+// RGBA8 packed with red in the lowest byte, read as 4 normalized GL_UNSIGNED_BYTE components.
+constexpr std::uint32_t PackColor(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255) noexcept
+{
+    return std::uint32_t{r} | std::uint32_t{g} << 8 | std::uint32_t{b} << 16 | std::uint32_t{a} << 24;
+}
+}// namespace Renderer
+#endif
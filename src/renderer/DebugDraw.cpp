@@ -0,0 +1,236 @@
+#include "renderer/DebugDraw.h"
+
+#ifndef NDEBUG
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "renderer/Shader.h"
+#include "renderer/StreamBuffer.h"
+
+namespace Renderer::DebugDraw
+{
+namespace
+{
+    const std::filesystem::path k_VertexShader   {"resources/shaders/debugdraw.vert"};
+    const std::filesystem::path k_FragmentShader {"resources/shaders/debugdraw.frag"};
+
+    // Lines past this in one frame are dropped.
+    constexpr std::size_t k_MaxVertices {65536};
+
+    struct Vertex
+    {
+        glm::vec2 position;
+        std::uint32_t color;
+    };
+
+    // GPU side, created by the first Flush() that has lines to draw.
+    struct LineRenderer
+    {
+        Shader shader {k_VertexShader, k_FragmentShader};
+        StreamBuffer vertexBuffer {GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(k_MaxVertices * sizeof(Vertex))};
+        GLuint VAO {0};
+
+        LineRenderer()
+        {
+            glGenVertexArrays(1, &VAO);
+            glBindVertexArray(VAO);
+            glEnableVertexAttribArray(0);
+            glEnableVertexAttribArray(1);
+            glBindVertexArray(0);
+        }
+
+        ~LineRenderer()
+        {
+            glDeleteVertexArrays(1, &VAO);
+        }
+    };
+
+    // Main thread only, like the rest of the renderer.
+    std::vector<Vertex> g_vertices;
+    std::unique_ptr<LineRenderer> g_renderer;
+    bool g_enabled {false};
+
+    void Push(glm::vec2 from, glm::vec2 to, std::uint32_t color)
+    {
+        if (g_vertices.size() + 2 <= k_MaxVertices)
+        {
+            g_vertices.push_back({from, color});
+            g_vertices.push_back({to, color});
+        }
+    }
+}// anonymous namespace
+
+void SetEnabled(bool enabled) noexcept
+{
+    g_enabled = enabled;
+    if (!enabled)
+    {
+        g_vertices.clear();
+    }
+}
+
+bool IsEnabled() noexcept
+{
+    return g_enabled;
+}
+
+void Line(glm::vec2 from, glm::vec2 to, std::uint32_t color)
+{
+    if (g_enabled)
+    {
+        Push(from, to, color);
+    }
+}
+
+void Polyline(std::span<const glm::vec2> points, std::uint32_t color)
+{
+    if (!g_enabled)
+    {
+        return;
+    }
+
+    for (std::size_t i {1}; i < points.size(); ++i)
+    {
+        Push(points[i - 1], points[i], color);
+    }
+}
+
+/*
+* {bounds} is {left, bottom, right, top}, as returned by GetAABB().
+*/
+void Box(const glm::vec4& bounds, std::uint32_t color)
+{
+    if (!g_enabled)
+    {
+        return;
+    }
+
+    Push({bounds.x, bounds.y}, {bounds.z, bounds.y}, color);
+    Push({bounds.z, bounds.y}, {bounds.z, bounds.w}, color);
+    Push({bounds.z, bounds.w}, {bounds.x, bounds.w}, color);
+    Push({bounds.x, bounds.w}, {bounds.x, bounds.y}, color);
+}
+
+void Circle(glm::vec2 center, float radius, std::uint32_t color, int segments)
+{
+    if (!g_enabled || segments < 3)
+    {
+        return;
+    }
+
+    const float step {2.0f * std::numbers::pi_v<float> / static_cast<float>(segments)};
+    glm::vec2 previous {center.x + radius, center.y};
+    for (int i {1}; i <= segments; ++i)
+    {
+        const float angle {step * static_cast<float>(i)};
+        const glm::vec2 point {center + radius * glm::vec2{std::cos(angle), std::sin(angle)}};
+        Push(previous, point, color);
+        previous = point;
+    }
+}
+
+void Arrow(glm::vec2 from, glm::vec2 to, std::uint32_t color, float headSize)
+{
+    if (!g_enabled)
+    {
+        return;
+    }
+
+    Push(from, to, color);
+
+    const glm::vec2 delta {to - from};
+    const float length {std::sqrt(delta.x * delta.x + delta.y * delta.y)};
+    if (length <= 0.0f)
+    {
+        return;
+    }
+
+    // Two barbs at 30 degrees either side of the shaft.
+    const glm::vec2 back {-delta / length * headSize};
+    const glm::vec2 side {-back.y * 0.577f, back.x * 0.577f}; // tan(30 degrees).
+    Push(to, to + back + side, color);
+    Push(to, to + back - side, color);
+}
+
+/*
+* Lines of a grid with {cellSize} cells aligned to the world origin, clipped to {bounds}.
+*/
+void Grid(const glm::vec4& bounds, float cellSize, std::uint32_t color)
+{
+    if (!g_enabled || cellSize <= 0.0f)
+    {
+        return;
+    }
+
+    for (float x {std::ceil(bounds.x / cellSize) * cellSize}; x <= bounds.z; x += cellSize)
+    {
+        Push({x, bounds.y}, {x, bounds.w}, color);
+    }
+    for (float y {std::ceil(bounds.y / cellSize) * cellSize}; y <= bounds.w; y += cellSize)
+    {
+        Push({bounds.x, y}, {bounds.z, y}, color);
+    }
+}
+
+/*
+* Draws everything recorded since the last flush with one call and starts over. Call once per
+* frame after the scene so lines stay on top; uses the 'Camera' uniform block.
+*/
+void Flush()
+{
+    if (g_vertices.empty())
+    {
+        return;
+    }
+
+    if (!g_renderer)
+    {
+        g_renderer = std::make_unique<LineRenderer>();
+    }
+
+    auto& renderer {*g_renderer};
+    renderer.vertexBuffer.BeginFrame();
+
+    const auto bytes {static_cast<GLsizeiptr>(g_vertices.size() * sizeof(Vertex))};
+    const auto allocation {renderer.vertexBuffer.Allocate(bytes)};
+    assert(allocation && "DebugDraw flushed more than once per frame.");
+
+    if (allocation)
+    {
+        std::memcpy(allocation.data, g_vertices.data(), static_cast<std::size_t>(bytes));
+        renderer.vertexBuffer.Commit(allocation);
+
+        glBindVertexArray(renderer.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, renderer.vertexBuffer.GetID());
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(allocation.offset + offsetof(Vertex, position)));
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), reinterpret_cast<const void*>(allocation.offset + offsetof(Vertex, color)));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        renderer.shader.Bind();
+        glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(g_vertices.size()));
+        renderer.shader.UnBind();
+        glBindVertexArray(0);
+    }
+
+    g_vertices.clear();
+}
+
+/*
+* Releases the GPU side, call while the context is still alive.
+*/
+void Shutdown()
+{
+    g_renderer.reset();
+    g_vertices.clear();
+}
+}// namespace Renderer::DebugDraw
+
+#endif
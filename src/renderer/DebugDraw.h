@@ -0,0 +1,52 @@
+#ifndef DEBUGDRAW_H
+#define DEBUGDRAW_H
+
+#include <cstdint>
+#include <span>
+
+#include <glm/glm.hpp>
+
+#include "renderer/Color.h"
+
+namespace Renderer
+{
+/*
+* Immediate-mode debug shapes in world space: call from anywhere during a frame, ex. a component's
+* OnRender(), and every line is drawn at once by Flush() with a single GL_LINES call from one
+* streamed vertex buffer. Shapes are only recorded while enabled (off by default).
+*
+* With NDEBUG the whole API is empty inline functions, release builds carry no code, buffers or
+* shaders for it. Colors are Renderer::PackColor() values.
+*/
+namespace DebugDraw
+{
+#ifndef NDEBUG
+void SetEnabled(bool enabled) noexcept;
+bool IsEnabled() noexcept;
+
+void Line(glm::vec2 from, glm::vec2 to, std::uint32_t color);
+void Polyline(std::span<const glm::vec2> points, std::uint32_t color);
+void Box(const glm::vec4& bounds, std::uint32_t color);
+void Circle(glm::vec2 center, float radius, std::uint32_t color, int segments = 24);
+void Arrow(glm::vec2 from, glm::vec2 to, std::uint32_t color, float headSize = 12.0f);
+void Grid(const glm::vec4& bounds, float cellSize, std::uint32_t color);
+
+void Flush();
+void Shutdown();
+#else
+inline void SetEnabled(bool) noexcept {}
+inline bool IsEnabled() noexcept {return false;}
+
+inline void Line(glm::vec2, glm::vec2, std::uint32_t) {}
+inline void Polyline(std::span<const glm::vec2>, std::uint32_t) {}
+inline void Box(const glm::vec4&, std::uint32_t) {}
+inline void Circle(glm::vec2, float, std::uint32_t, int = 24) {}
+inline void Arrow(glm::vec2, glm::vec2, std::uint32_t, float = 12.0f) {}
+inline void Grid(const glm::vec4&, float, std::uint32_t) {}
+
+inline void Flush() {}
+inline void Shutdown() {}
+#endif
+}// namespace DebugDraw
+}// namespace Renderer
+#endif
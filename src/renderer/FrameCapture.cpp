@@ -0,0 +1,170 @@
+#include "renderer/FrameCapture.h"
+
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <print>
+
+namespace Renderer
+{
+FrameCapture::FrameCapture(Callback onFrame, std::size_t ringSize):
+m_slots(ringSize == 0 ? 1 : ringSize),
+m_next(0),
+m_onFrame(std::move(onFrame))
+{
+    for (auto& slot: m_slots)
+    {
+        glGenBuffers(1, &slot.buffer);
+    }
+}
+
+FrameCapture::~FrameCapture()
+{
+    for (auto& slot: m_slots)
+    {
+        if (slot.fence)
+        {
+            glDeleteSync(slot.fence);
+        }
+        glDeleteBuffers(1, &slot.buffer);
+    }
+}
+
+/*
+* Maps a finished slot, hands its pixels to the callback and frees it. Blocks until the copy is
+* done if it is not yet.
+*/
+void FrameCapture::Collect(Slot& slot)
+{
+    glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const auto size {static_cast<GLsizeiptr>(slot.width) * slot.height * 4};
+    if (const void* mapped {glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT)})
+    {
+        if (m_onFrame)
+        {
+            m_onFrame(slot.frame, slot.width, slot.height, {static_cast<const std::byte*>(mapped), static_cast<std::size_t>(size)});
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    else
+    {
+        std::println(stderr, "Failed to map capture of frame {}.", slot.frame);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+/*
+* Queues a copy of the bound read framebuffer's {width}x{height} color. Call after the frame's draw
+* calls and before the framebuffer is cleared for the next one.
+*/
+void FrameCapture::Capture(std::uint64_t frame, GLsizei width, GLsizei height)
+{
+    auto& slot {m_slots[m_next]};
+    if (slot.fence)
+    {
+        // Ring overrun, every slot is in flight.
+        Collect(slot);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+
+    const auto size {static_cast<GLsizeiptr>(width) * height * 4};
+    if (size > slot.size)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        slot.size = size;
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence  = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Poll() waits without the flush bit, the fence must reach the GPU or it never signals.
+    glFlush();
+
+    slot.frame  = frame;
+    slot.width  = width;
+    slot.height = height;
+
+    m_next = (m_next + 1) % m_slots.size();
+}
+
+/*
+* Delivers every capture whose copy has finished, oldest first, without waiting.
+*/
+void FrameCapture::Poll()
+{
+    for (std::size_t i {0}; i < m_slots.size(); ++i)
+    {
+        auto& slot {m_slots[(m_next + i) % m_slots.size()]};
+        if (!slot.fence)
+        {
+            continue;
+        }
+
+        if (glClientWaitSync(slot.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+        {
+            // Later captures can not be done before this one.
+            return;
+        }
+        Collect(slot);
+    }
+}
+
+/*
+* Waits for and delivers every capture still in flight.
+*/
+void FrameCapture::Flush()
+{
+    for (std::size_t i {0}; i < m_slots.size(); ++i)
+    {
+        if (auto& slot {m_slots[(m_next + i) % m_slots.size()]}; slot.fence)
+        {
+            Collect(slot);
+        }
+    }
+}
+
+std::size_t FrameCapture::GetPendingCount() const noexcept
+{
+    std::size_t pending {0};
+    for (const auto& slot: m_slots)
+    {
+        pending += slot.fence != nullptr;
+    }
+    return pending;
+}
+
+bool WritePPM(const std::filesystem::path& path, GLsizei width, GLsizei height, std::span<const std::byte> pixels)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::println(stderr, "Failed to open '{}' for writing.", path.string());
+        return false;
+    }
+
+    file << std::format("P6\n{} {}\n255\n", width, height);
+
+    std::vector<char> row(static_cast<std::size_t>(width) * 3);
+    for (GLsizei y {height - 1}; y >= 0; --y)
+    {
+        const auto* source {pixels.data() + static_cast<std::size_t>(y) * width * 4};
+        for (GLsizei x {0}; x < width; ++x)
+        {
+            row[x * 3 + 0] = static_cast<char>(source[x * 4 + 0]);
+            row[x * 3 + 1] = static_cast<char>(source[x * 4 + 1]);
+            row[x * 3 + 2] = static_cast<char>(source[x * 4 + 2]);
+        }
+        file.write(row.data(), static_cast<std::streamsize>(row.size()));
+    }
+
+    return static_cast<bool>(file);
+}
+}// namespace Renderer
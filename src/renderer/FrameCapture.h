@@ -0,0 +1,69 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include <GL/glew.h>
+
+namespace Renderer
+{
+/*
+* Asynchronous framebuffer readback. Capture() starts a glReadPixels into a pixel buffer object,
+* which returns immediately; the copy runs on the GPU behind the frame. A fence marks when it is
+* done and Poll() maps finished buffers a few frames later, so reading pixels never stalls the
+* pipeline. The ring holds {ringSize} captures in flight; only when all of them are still pending
+* does Capture() wait for the oldest one.
+*
+* Pixels handed to the callback are RGBA8, bottom row first as OpenGL stores them, and are only
+* valid during the call.
+*/
+class FrameCapture
+{
+public:
+
+    using Callback = std::function<void(std::uint64_t frame, GLsizei width, GLsizei height, std::span<const std::byte> pixels)>;
+
+private:
+
+    struct Slot
+    {
+        GLuint buffer     {0};
+        GLsizeiptr size   {0};
+        GLsync fence      {nullptr}; // null while the slot is free.
+        std::uint64_t frame {0};
+        GLsizei width     {0};
+        GLsizei height    {0};
+    };
+
+    std::vector<Slot> m_slots;
+    std::size_t m_next;   // slot the next capture goes into, oldest pending one when all are busy.
+    Callback m_onFrame;
+
+    void Collect(Slot& slot);
+
+public:
+
+    explicit FrameCapture(Callback onFrame, std::size_t ringSize = 3);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&)            = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+    FrameCapture(FrameCapture&&)                 = delete;
+    FrameCapture& operator=(FrameCapture&&)      = delete;
+
+    void Capture(std::uint64_t frame, GLsizei width, GLsizei height);
+    void Poll();
+    void Flush();
+
+    std::size_t GetPendingCount() const noexcept;
+};
+
+// Writes RGBA8 pixels read back bottom row first as a binary PPM, top row first.
+bool WritePPM(const std::filesystem::path& path, GLsizei width, GLsizei height, std::span<const std::byte> pixels);
+}// namespace Renderer
+#endif
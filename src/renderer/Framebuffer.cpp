@@ -0,0 +1,102 @@
+#include "renderer/Framebuffer.h"
+
+#include <format>
+#include <stdexcept>
+
+namespace Renderer
+{
+Framebuffer::Framebuffer(GLsizei width, GLsizei height):
+m_framebuffer(0),
+m_color(0),
+m_depthStencil(0),
+m_width(0),
+m_height(0)
+{
+    glGenFramebuffers(1, &m_framebuffer);
+    glGenTextures(1, &m_color);
+    glGenRenderbuffers(1, &m_depthStencil);
+
+    Resize(width, height);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_color, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthStencil);
+
+    const GLenum status {glCheckFramebufferStatus(GL_FRAMEBUFFER)};
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        glDeleteRenderbuffers(1, &m_depthStencil);
+        glDeleteTextures(1, &m_color);
+        glDeleteFramebuffers(1, &m_framebuffer);
+        throw std::runtime_error(std::format("Framebuffer incomplete, status 0x{:x}.", status));
+    }
+}
+
+Framebuffer::~Framebuffer()
+{
+    glDeleteRenderbuffers(1, &m_depthStencil);
+    glDeleteTextures(1, &m_color);
+    glDeleteFramebuffers(1, &m_framebuffer);
+}
+
+/*
+* Binds for drawing and reading and sets the viewport to the whole target.
+*/
+void Framebuffer::Bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_width, m_height);
+}
+
+void Framebuffer::UnBind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/*
+* Reallocates both attachments, they stay attached since the object names do not change.
+*/
+void Framebuffer::Resize(GLsizei width, GLsizei height)
+{
+    if (width == m_width && height == m_height)
+    {
+        return;
+    }
+
+    m_width  = width;
+    m_height = height;
+
+    glBindTexture(GL_TEXTURE_2D, m_color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthStencil);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_width, m_height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+}
+
+GLuint Framebuffer::GetID() const noexcept
+{
+    return m_framebuffer;
+}
+
+GLuint Framebuffer::GetColorTexture() const noexcept
+{
+    return m_color;
+}
+
+GLsizei Framebuffer::GetWidth() const noexcept
+{
+    return m_width;
+}
+
+GLsizei Framebuffer::GetHeight() const noexcept
+{
+    return m_height;
+}
+}// namespace Renderer
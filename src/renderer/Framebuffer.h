@@ -0,0 +1,43 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <GL/glew.h>
+
+namespace Renderer
+{
+/*
+* Offscreen render target: an RGBA8 color texture and a depth/stencil renderbuffer. Stands in for
+* the window's default framebuffer when rendering headless.
+*/
+class Framebuffer
+{
+private:
+
+    GLuint m_framebuffer;
+    GLuint m_color;
+    GLuint m_depthStencil;
+
+    GLsizei m_width;
+    GLsizei m_height;
+
+public:
+
+    Framebuffer(GLsizei width, GLsizei height);
+    ~Framebuffer();
+
+    Framebuffer(const Framebuffer&)            = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+    Framebuffer(Framebuffer&&)                 = delete;
+    Framebuffer& operator=(Framebuffer&&)      = delete;
+
+    void Bind() const;
+    void UnBind() const;
+    void Resize(GLsizei width, GLsizei height);
+
+    GLuint GetID() const noexcept;
+    GLuint GetColorTexture() const noexcept;
+    GLsizei GetWidth() const noexcept;
+    GLsizei GetHeight() const noexcept;
+};
+}// namespace Renderer
+#endif
@@ -0,0 +1,150 @@
+#include "renderer/GeometryRegistry.h"
+
+#include <cassert>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "renderer/Packing.h"
+
+namespace Renderer
+{
+namespace
+{
+    constexpr std::size_t k_MeshCount {static_cast<std::size_t>(Mesh::Count)};
+
+    // Indexed by Mesh. Every corner is exact as a half float, the buffer stores them packed.
+    constexpr std::array<std::array<glm::vec2, GeometryRegistry::k_VerticesPerQuad>, k_MeshCount> k_MeshVertices =
+    {{
+        {{{0.0f, 1.0f}, {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}}},
+        {{{-0.5f, 0.5f}, {-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}}},
+        {{{-1.0f, 1.0f}, {-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}}},
+    }};
+
+    using PackedCorner = glm::u16vec2;
+
+    const void* MeshOffset(Mesh mesh) noexcept
+    {
+        return reinterpret_cast<const void*>(static_cast<std::size_t>(mesh) * GeometryRegistry::k_VerticesPerQuad * sizeof(PackedCorner));
+    }
+}// anonymous namespace
+
+GeometryRegistry::GeometryRegistry():
+m_vertexBuffer(0),
+m_quadIndexBuffer(0),
+m_vertexArrays{},
+m_initialized(false)
+{}
+
+GeometryRegistry& GeometryRegistry::Instance()
+{
+    static GeometryRegistry registry;
+    return registry;
+}
+
+/*
+* Uploads the meshes and the quad index buffer, once the GL context is current.
+*/
+void GeometryRegistry::Initialize()
+{
+    if (m_initialized)
+    {
+        return;
+    }
+
+    std::vector<GLuint> indices;
+    indices.reserve(k_MaxQuads * k_IndicesPerQuad);
+    for (GLuint quad {0}; quad < k_MaxQuads; ++quad)
+    {
+        const GLuint first {quad * static_cast<GLuint>(k_VerticesPerQuad)};
+        indices.insert(indices.end(), {first, first + 1, first + 2, first + 2, first + 3, first});
+    }
+
+    std::vector<PackedCorner> corners;
+    corners.reserve(k_MeshCount * k_VerticesPerQuad);
+    for (const auto& mesh: k_MeshVertices)
+    {
+        for (const auto& corner: mesh)
+        {
+            corners.push_back(PackHalf(corner));
+        }
+    }
+
+    glGenBuffers(1, &m_vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(corners.size() * sizeof(PackedCorner)), corners.data(), GL_STATIC_DRAW);
+
+    glGenVertexArrays(static_cast<GLsizei>(m_vertexArrays.size()), m_vertexArrays.data());
+    glBindVertexArray(m_vertexArrays[0]);
+
+    // Created with the first vertex array bound, element buffer bindings are vertex array state.
+    glGenBuffers(1, &m_quadIndexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(GLuint)), indices.data(), GL_STATIC_DRAW);
+
+    m_initialized = true;
+
+    for (std::size_t mesh {0}; mesh < k_MeshCount; ++mesh)
+    {
+        glBindVertexArray(m_vertexArrays[mesh]);
+        AttachMesh(static_cast<Mesh>(mesh), 0);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/*
+* Releases the buffers, call while the context is still alive and after every user is gone.
+*/
+void GeometryRegistry::Shutdown()
+{
+    if (!m_initialized)
+    {
+        return;
+    }
+
+    glDeleteVertexArrays(static_cast<GLsizei>(m_vertexArrays.size()), m_vertexArrays.data());
+    glDeleteBuffers(1, &m_quadIndexBuffer);
+    glDeleteBuffers(1, &m_vertexBuffer);
+
+    m_vertexArrays    = {};
+    m_quadIndexBuffer = 0;
+    m_vertexBuffer    = 0;
+    m_initialized     = false;
+}
+
+/*
+* Vertex array with {mesh} as a vec2 at attribute 0 and the quad indices bound, drawn with
+* k_IndicesPerQuad indices.
+*/
+GLuint GeometryRegistry::GetVertexArray(Mesh mesh) const noexcept
+{
+    assert(m_initialized && "GeometryRegistry used before Initialize().");
+    return m_vertexArrays[static_cast<std::size_t>(mesh)];
+}
+
+/*
+* Points {attribute} of the bound vertex array at {mesh}'s corners, half floats read as a vec2, and
+* binds the quad indices.
+*/
+void GeometryRegistry::AttachMesh(Mesh mesh, GLuint attribute) const
+{
+    assert(m_initialized && "GeometryRegistry used before Initialize().");
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    glVertexAttribPointer(attribute, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedCorner), MeshOffset(mesh));
+    glEnableVertexAttribArray(attribute);
+
+    AttachQuadIndices();
+}
+
+/*
+* Binds the quad index buffer to the bound vertex array, for batches streaming their own corners.
+*/
+void GeometryRegistry::AttachQuadIndices() const
+{
+    assert(m_initialized && "GeometryRegistry used before Initialize().");
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndexBuffer);
+}
+}// namespace Renderer
@@ -0,0 +1,63 @@
+#ifndef GEOMETRYREGISTRY_H
+#define GEOMETRYREGISTRY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <GL/glew.h>
+
+namespace Renderer
+{
+// Immutable meshes owned by the GeometryRegistry, four vec2 corners each: top-left, bottom-left,
+// bottom-right, top-right.
+enum class Mesh : std::uint8_t
+{
+    UnitQuad,     // 0 to 1, origin at the bottom-left corner.
+    CenteredQuad, // -0.5 to 0.5.
+    ScreenQuad,   // -1 to 1, covers the viewport in normalized device coordinates.
+
+    Count
+};
+
+/*
+* Process-wide static geometry, created once after the GL context: every mesh lives in one vertex
+* buffer, and one index buffer holds '0, 1, 2, 2, 3, 0' patterns for up to k_MaxQuads quads, so
+* quad i of a batch uses vertices 4i to 4i+3. Any mesh drawn alone uses the first six indices.
+*
+* Renderers without per-instance data draw with GetVertexArray(); the ones that add their own
+* attributes create a vertex array and attach a mesh or the quad indices to it.
+*/
+class GeometryRegistry
+{
+private:
+
+    GLuint m_vertexBuffer;
+    GLuint m_quadIndexBuffer;
+    std::array<GLuint, static_cast<std::size_t>(Mesh::Count)> m_vertexArrays;
+    bool m_initialized;
+
+    GeometryRegistry();
+
+public:
+
+    static constexpr std::size_t k_MaxQuads {65536};
+    static constexpr std::size_t k_VerticesPerQuad {4};
+    static constexpr GLsizei k_IndicesPerQuad {6};
+
+    static GeometryRegistry& Instance();
+
+    ~GeometryRegistry() = default;
+
+    GeometryRegistry(const GeometryRegistry&)            = delete;
+    GeometryRegistry& operator=(const GeometryRegistry&) = delete;
+
+    void Initialize();
+    void Shutdown();
+
+    GLuint GetVertexArray(Mesh mesh) const noexcept;
+    void AttachMesh(Mesh mesh, GLuint attribute) const;
+    void AttachQuadIndices() const;
+};
+}// namespace Renderer
+#endif
@@ -0,0 +1,166 @@
+#include "renderer/LayerCache.h"
+
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+
+#include "renderer/GeometryRegistry.h"
+
+namespace Renderer
+{
+namespace
+{
+    const std::filesystem::path k_VertexShader   {"resources/shaders/layercache.vert"};
+    const std::filesystem::path k_FragmentShader {"resources/shaders/layercache.frag"};
+
+    // Both are {left, bottom, right, top}.
+    bool Contains(const glm::vec4& outer, const glm::vec4& inner) noexcept
+    {
+        return inner.x >= outer.x && inner.y >= outer.y && inner.z <= outer.z && inner.w <= outer.w;
+    }
+}// anonymous namespace
+
+LayerCache::LayerCache(int textureSlot, float margin):
+m_shader(k_VertexShader, k_FragmentShader),
+m_framebuffer(0),
+m_texture(0),
+m_textureSlot(textureSlot),
+m_VAO(GeometryRegistry::Instance().GetVertexArray(Mesh::UnitQuad)),
+m_size(0),
+m_rect(0.0f),
+m_margin(margin),
+m_contentKey(0),
+m_valid(false),
+m_savedFramebuffer(0),
+m_savedViewport{}
+{
+    glGenFramebuffers(1, &m_framebuffer);
+
+    m_shader.Bind();
+    m_shader.SetUniform1i("u_Layer", m_textureSlot);
+    m_shader.UnBind();
+}
+
+LayerCache::~LayerCache()
+{
+    glDeleteFramebuffers(1, &m_framebuffer);
+    glDeleteTextures(1, &m_texture);
+}
+
+glm::ivec2 LayerCache::SizeFor(const glm::vec4& viewRect) const noexcept
+{
+    const glm::vec2 view {viewRect.z - viewRect.x, viewRect.w - viewRect.y};
+    return glm::ivec2{glm::ceil(view + 2.0f * m_margin)} + 1;
+}
+
+/*
+* Reallocates the color texture, only when the viewport changes size.
+*/
+void LayerCache::Resize(glm::ivec2 size)
+{
+    m_size = size;
+
+    if (m_texture == 0)
+    {
+        glGenTextures(1, &m_texture);
+    }
+
+    glActiveTexture(GL_TEXTURE0 + m_textureSlot);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_size.x, m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    // Cached pixels map one to one onto the screen, nearest keeps them sharp while scrolling.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0);
+    assert(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/*
+* True while the cached texture can be drawn for {viewRect} as is.
+*/
+bool LayerCache::IsCurrent(const glm::vec4& viewRect, std::uint64_t contentKey) const noexcept
+{
+    return m_valid && contentKey == m_contentKey && SizeFor(viewRect) == m_size && Contains(m_rect, viewRect);
+}
+
+void LayerCache::Invalidate() noexcept
+{
+    m_valid = false;
+}
+
+/*
+* Redirects rendering into the cache. Returns the world rectangle the caller must cover, the view
+* grown by the margin and snapped to whole pixels; the framebuffer's viewport spans it exactly.
+*/
+glm::vec4 LayerCache::Begin(const glm::vec4& viewRect, std::uint64_t contentKey)
+{
+    if (const auto size {SizeFor(viewRect)}; size != m_size)
+    {
+        Resize(size);
+    }
+
+    const glm::vec2 origin {glm::floor(glm::vec2{viewRect.x, viewRect.y} - m_margin)};
+    m_rect       = {origin.x, origin.y, origin.x + m_size.x, origin.y + m_size.y};
+    m_contentKey = contentKey;
+    m_valid      = true;
+
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_savedFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, m_savedViewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_size.x, m_size.y);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    return m_rect;
+}
+
+void LayerCache::End()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(m_savedFramebuffer));
+    glViewport(m_savedViewport[0], m_savedViewport[1], m_savedViewport[2], m_savedViewport[3]);
+}
+
+/*
+* Draws the cached layer: one quad over the cached rectangle, the camera pans it. Marked as
+* covering the view while the cached rectangle contains it; only opaque submissions act on that.
+*/
+void LayerCache::Submit(RenderQueue& queue, float depth, bool translucent) const
+{
+    if (!m_valid)
+    {
+        return;
+    }
+
+    RenderCommand command
+    {
+        .shader      = &m_shader,
+        .texture     = m_texture,
+        .textureSlot = m_textureSlot,
+        .vertexArray = m_VAO,
+        .indexCount  = GeometryRegistry::k_IndicesPerQuad,
+        .coversView  = Contains(m_rect, queue.GetViewRect()),
+    };
+
+    queue.Submit(command, Affine2D::FromRect(m_rect), depth, translucent);
+}
+
+GLuint LayerCache::GetTextureID() const noexcept
+{
+    return m_texture;
+}
+
+const glm::vec4& LayerCache::GetRect() const noexcept
+{
+    return m_rect;
+}
+}// namespace Renderer
@@ -0,0 +1,70 @@
+#ifndef LAYERCACHE_H
+#define LAYERCACHE_H
+
+#include <cstdint>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "renderer/RenderQueue.h"
+#include "renderer/Shader.h"
+
+namespace Renderer
+{
+/*
+* Render-to-texture cache for a layer that rarely changes. The layer is rendered once into a
+* framebuffer covering the view plus a margin, then drawn every frame as one textured quad placed
+* in world space so the camera scrolls it. It is rendered again only when its content key changes,
+* the viewport is resized, or the view leaves the cached rectangle.
+*
+* One world unit is one framebuffer pixel, as set up by CameraBuffer.
+*/
+class LayerCache
+{
+private:
+
+    Shader m_shader;
+
+    GLuint m_framebuffer;
+    GLuint m_texture;
+    GLint  m_textureSlot;
+
+    GLuint m_VAO; // GeometryRegistry's unit quad.
+
+    glm::ivec2 m_size;  // texture size in pixels.
+    glm::vec4 m_rect;   // cached world rectangle {left, bottom, right, top}.
+    float m_margin;     // world units rendered past each edge of the view.
+
+    std::uint64_t m_contentKey;
+    bool m_valid;
+
+    // Restored by End().
+    GLint m_savedFramebuffer;
+    GLint m_savedViewport[4];
+
+    glm::ivec2 SizeFor(const glm::vec4& viewRect) const noexcept;
+    void Resize(glm::ivec2 size);
+
+public:
+
+    explicit LayerCache(int textureSlot, float margin = 128.0f);
+    ~LayerCache();
+
+    LayerCache(const LayerCache&)            = delete;
+    LayerCache& operator=(const LayerCache&) = delete;
+    LayerCache(LayerCache&&)                 = delete;
+    LayerCache& operator=(LayerCache&&)      = delete;
+
+    bool IsCurrent(const glm::vec4& viewRect, std::uint64_t contentKey) const noexcept;
+    void Invalidate() noexcept;
+
+    glm::vec4 Begin(const glm::vec4& viewRect, std::uint64_t contentKey);
+    void End();
+
+    void Submit(RenderQueue& queue, float depth, bool translucent) const;
+
+    GLuint GetTextureID() const noexcept;
+    const glm::vec4& GetRect() const noexcept;
+};
+}// namespace Renderer
+#endif
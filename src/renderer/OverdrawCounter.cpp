@@ -0,0 +1,143 @@
+#include "renderer/OverdrawCounter.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+
+#include <glm/glm.hpp>
+
+#include "renderer/GeometryRegistry.h"
+
+namespace Renderer
+{
+namespace
+{
+    const std::filesystem::path k_VertexShader   {"resources/shaders/heatmap.vert"};
+    const std::filesystem::path k_FragmentShader {"resources/shaders/heatmap.frag"};
+
+    // Colour for pixels shaded at least {index} times; index 0 is never shaded.
+    constexpr std::array<glm::vec4, 7> k_HeatmapColors
+    {{
+        {0.0f, 0.0f, 0.0f, 1.0f},  // 0
+        {0.0f, 0.0f, 0.6f, 1.0f},  // 1
+        {0.0f, 0.6f, 0.0f, 1.0f},  // 2
+        {0.9f, 0.9f, 0.0f, 1.0f},  // 3
+        {1.0f, 0.5f, 0.0f, 1.0f},  // 4
+        {0.9f, 0.0f, 0.0f, 1.0f},  // 5
+        {1.0f, 1.0f, 1.0f, 1.0f},  // 6 and more
+    }};
+}// anonymous namespace
+
+OverdrawCounter::OverdrawCounter():
+m_shader(k_VertexShader, k_FragmentShader),
+m_viewport{},
+m_total()
+{}
+
+void OverdrawCounter::ReadStencil(std::vector<std::uint8_t>& out) const
+{
+    out.resize(static_cast<std::size_t>(m_viewport[2]) * static_cast<std::size_t>(m_viewport[3]));
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3], GL_STENCIL_INDEX, GL_UNSIGNED_BYTE, out.data());
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+}
+
+/*
+* Clears the stencil and starts counting, before the frame's first draw.
+*/
+void OverdrawCounter::Begin()
+{
+    glGetIntegerv(GL_VIEWPORT, m_viewport);
+    m_previous.assign(static_cast<std::size_t>(m_viewport[2]) * static_cast<std::size_t>(m_viewport[3]), 0);
+    m_layers.clear();
+
+    glStencilMask(0xFF);
+    glClearStencil(0);
+    glClear(GL_STENCIL_BUFFER_BIT);
+
+    glEnable(GL_STENCIL_TEST);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+}
+
+/*
+* Everything {layer} draws must have been issued.
+*/
+void OverdrawCounter::EndLayer(std::uint8_t layer)
+{
+    ReadStencil(m_current);
+
+    std::uint64_t sum {0};
+    std::uint32_t max {0};
+    for (std::size_t i {0}; i < m_current.size(); ++i)
+    {
+        const std::uint32_t count {static_cast<std::uint32_t>(m_current[i] - m_previous[i])};
+        sum += count;
+        max  = std::max(max, count);
+    }
+
+    const float pixels {static_cast<float>(std::max<std::size_t>(m_current.size(), 1))};
+    m_layers.push_back({layer, static_cast<float>(sum) / pixels, max});
+    m_previous.swap(m_current);
+}
+
+/*
+* Stops counting; the stencil keeps the frame's totals for DrawHeatmap().
+*/
+void OverdrawCounter::End()
+{
+    std::uint64_t sum {0};
+    std::uint32_t max {0};
+    for (const std::uint8_t count: m_previous)
+    {
+        sum += count;
+        max  = std::max<std::uint32_t>(max, count);
+    }
+
+    const float pixels {static_cast<float>(std::max<std::size_t>(m_previous.size(), 1))};
+    m_total = {0, static_cast<float>(sum) / pixels, max};
+
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    glDisable(GL_STENCIL_TEST);
+}
+
+/*
+* Paints the counts over the frame, band by band: band n passes where the stencil is >= n, so
+* higher bands overwrite lower ones. Leaves blending and the stencil test disabled.
+*/
+void OverdrawCounter::DrawHeatmap() const
+{
+    glDisable(GL_BLEND);
+    glEnable(GL_STENCIL_TEST);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+
+    m_shader.Bind();
+    glBindVertexArray(GeometryRegistry::Instance().GetVertexArray(Mesh::ScreenQuad));
+
+    for (std::size_t band {0}; band < k_HeatmapColors.size(); ++band)
+    {
+        // Passes when band <= stencil.
+        glStencilFunc(GL_LEQUAL, static_cast<GLint>(band), 0xFF);
+
+        const auto& color {k_HeatmapColors[band]};
+        m_shader.SetUniform4f("u_Color", color.x, color.y, color.z, color.w);
+        glDrawElements(GL_TRIANGLES, GeometryRegistry::k_IndicesPerQuad, GL_UNSIGNED_INT, nullptr);
+    }
+
+    glBindVertexArray(0);
+    m_shader.UnBind();
+    glDisable(GL_STENCIL_TEST);
+}
+
+std::span<const OverdrawStats> OverdrawCounter::GetLayers() const noexcept
+{
+    return m_layers;
+}
+
+const OverdrawStats& OverdrawCounter::GetTotal() const noexcept
+{
+    return m_total;
+}
+}// namespace Renderer
@@ -0,0 +1,63 @@
+#ifndef OVERDRAWCOUNTER_H
+#define OVERDRAWCOUNTER_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "renderer/Shader.h"
+
+namespace Renderer
+{
+// Fragments shaded by one layer's commands during a frame.
+struct OverdrawStats
+{
+    std::uint8_t layer   {0};
+    float average        {0.0f}; // fragments per pixel of the viewport.
+    std::uint32_t max    {0};    // most fragments on a single pixel, saturates at 255.
+};
+
+/*
+* Debug instrumentation counting how often every pixel is shaded. While counting, each fragment
+* that passes increments the stencil buffer (GL_INCR, so no shader changes); the stencil is read
+* back at every layer boundary and the difference to the previous read gives that layer's counts.
+* DrawHeatmap() then replaces the frame with one colour band per count, using stencil-tested
+* full-screen quads.
+*
+* Needs an 8-bit stencil buffer on the bound framebuffer, the default one or Framebuffer. Reads
+* are synchronous, this is for measuring, not for shipping frames.
+*/
+class OverdrawCounter
+{
+private:
+
+    Shader m_shader;
+
+    GLint m_viewport[4];
+    std::vector<std::uint8_t> m_previous; // stencil at the last layer boundary.
+    std::vector<std::uint8_t> m_current;
+    std::vector<OverdrawStats> m_layers;
+    OverdrawStats m_total;
+
+    void ReadStencil(std::vector<std::uint8_t>& out) const;
+
+public:
+
+    OverdrawCounter();
+
+    OverdrawCounter(const OverdrawCounter&)            = delete;
+    OverdrawCounter& operator=(const OverdrawCounter&) = delete;
+
+    void Begin();
+    void EndLayer(std::uint8_t layer);
+    void End();
+
+    void DrawHeatmap() const;
+
+    std::span<const OverdrawStats> GetLayers() const noexcept;
+    const OverdrawStats& GetTotal() const noexcept;
+};
+}// namespace Renderer
+#endif
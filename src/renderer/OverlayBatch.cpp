@@ -0,0 +1,171 @@
+#include "renderer/OverlayBatch.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+
+namespace Renderer
+{
+namespace
+{
+    const std::filesystem::path k_VertexShader   {"resources/shaders/overlay.vert"};
+    const std::filesystem::path k_FragmentShader {"resources/shaders/overlay.frag"};
+
+    constexpr std::size_t k_VerticesPerQuad {GeometryRegistry::k_VerticesPerQuad};
+    constexpr std::size_t k_IndicesPerQuad  {GeometryRegistry::k_IndicesPerQuad};
+}// anonymous namespace
+
+OverlayBatch::OverlayBatch(GLint textureSlot):
+m_shader(k_VertexShader, k_FragmentShader),
+m_font(),
+m_textureSlot(textureSlot),
+m_VAO(0),
+m_vertexBuffer(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(k_MaxQuads * k_VerticesPerQuad * sizeof(Vertex))),
+m_indexCount(0)
+{
+    m_vertices.reserve(k_MaxQuads * k_VerticesPerQuad);
+
+    glGenVertexArrays(1, &m_VAO);
+    glBindVertexArray(m_VAO);
+
+    // Quads use the shared quad index buffer, every frame only streams vertices.
+    GeometryRegistry::Instance().AttachQuadIndices();
+
+    // Pointed at the frame's stream allocation by Upload().
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+
+    glBindVertexArray(0);
+
+    m_shader.Bind();
+    m_shader.SetUniform1i("u_Font", m_textureSlot);
+    m_shader.UnBind();
+}
+
+OverlayBatch::~OverlayBatch()
+{
+    glDeleteVertexArrays(1, &m_VAO);
+}
+
+void OverlayBatch::BeginFrame()
+{
+    m_vertices.clear();
+    m_indexCount = 0;
+    m_vertexBuffer.BeginFrame();
+}
+
+void OverlayBatch::AddQuad(glm::vec2 topLeft, glm::vec2 size, const glm::vec4& texRect, std::uint32_t color)
+{
+    if (m_vertices.size() == k_MaxQuads * k_VerticesPerQuad)
+    {
+        return;
+    }
+
+    const glm::vec2 bottomRight {topLeft + size};
+    m_vertices.push_back({{topLeft.x,     topLeft.y},     {texRect.x, texRect.y}, color});
+    m_vertices.push_back({{topLeft.x,     bottomRight.y}, {texRect.x, texRect.w}, color});
+    m_vertices.push_back({{bottomRight.x, bottomRight.y}, {texRect.z, texRect.w}, color});
+    m_vertices.push_back({{bottomRight.x, topLeft.y},     {texRect.z, texRect.y}, color});
+}
+
+void OverlayBatch::AddRect(glm::vec2 topLeft, glm::vec2 size, std::uint32_t color)
+{
+    const auto texel {BitmapFont::GetSolidTexel()};
+    AddQuad(topLeft, size, {texel, texel}, color);
+}
+
+/*
+* Lays {text} out left to right, '\n' starts a new line. Returns the width of the longest line in
+* pixels. Spaces take room but add no quad.
+*/
+float OverlayBatch::AddText(glm::vec2 topLeft, std::string_view text, std::uint32_t color, float scale)
+{
+    const float advance {BitmapFont::k_GlyphSize * scale};
+
+    glm::vec2 pen {topLeft};
+    float width {0.0f};
+    for (const char glyph: text)
+    {
+        if (glyph == '\n')
+        {
+            pen = {topLeft.x, pen.y + advance};
+            continue;
+        }
+
+        if (glyph != ' ')
+        {
+            AddQuad(pen, glm::vec2{advance}, BitmapFont::GetGlyphRect(glyph), color);
+        }
+        pen.x += advance;
+        width  = std::max(width, pen.x - topLeft.x);
+    }
+    return width;
+}
+
+/*
+* Copies the frame's quads into the stream buffer and points the vertex array at them. Call once
+* per frame before the command is executed.
+*/
+void OverlayBatch::Upload(glm::vec2 screenSize)
+{
+    m_indexCount = 0;
+    if (m_vertices.empty())
+    {
+        return;
+    }
+
+    const auto bytes {static_cast<GLsizeiptr>(m_vertices.size() * sizeof(Vertex))};
+    const auto allocation {m_vertexBuffer.Allocate(bytes)};
+    assert(allocation && "Overlay uploaded more than once per frame.");
+    if (!allocation)
+    {
+        return;
+    }
+
+    std::memcpy(allocation.data, m_vertices.data(), static_cast<std::size_t>(bytes));
+    m_vertexBuffer.Commit(allocation);
+
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer.GetID());
+
+    const auto offset = [&allocation](std::size_t member)
+    {
+        return reinterpret_cast<const void*>(allocation.offset + member);
+    };
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), offset(offsetof(Vertex, position)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), offset(offsetof(Vertex, texCoord)));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), offset(offsetof(Vertex, color)));
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_shader.Bind();
+    m_shader.SetUniform2f("u_Screen", screenSize.x, screenSize.y);
+    m_shader.UnBind();
+
+    m_indexCount = static_cast<GLsizei>(m_vertices.size() / k_VerticesPerQuad * k_IndicesPerQuad);
+}
+
+bool OverlayBatch::IsEmpty() const noexcept
+{
+    return m_indexCount == 0;
+}
+
+/*
+* Draws everything uploaded this frame, submit it translucent on the topmost layer.
+*/
+RenderCommand OverlayBatch::GetCommand() const noexcept
+{
+    return RenderCommand
+    {
+        .shader      = &m_shader,
+        .texture     = m_font.GetTextureID(),
+        .textureSlot = m_textureSlot,
+        .vertexArray = m_VAO,
+        .indexCount  = m_indexCount,
+    };
+}
+}// namespace Renderer
@@ -0,0 +1,73 @@
+#ifndef OVERLAYBATCH_H
+#define OVERLAYBATCH_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "renderer/BitmapFont.h"
+#include "renderer/Color.h"
+#include "renderer/GeometryRegistry.h"
+#include "renderer/RenderQueue.h"
+#include "renderer/Shader.h"
+#include "renderer/StreamBuffer.h"
+
+namespace Renderer
+{
+/*
+* Screen-space text and rectangles for debug overlays, in pixels from the top-left corner. Text
+* and rectangles sample the same BitmapFont atlas, so everything added during a frame is uploaded
+* once and drawn with a single RenderCommand; the camera does not apply.
+*/
+class OverlayBatch
+{
+public:
+
+    struct Vertex
+    {
+        glm::vec2 position;  // pixels, y down.
+        glm::vec2 texCoord;
+        std::uint32_t color; // PackColor().
+    };
+
+    static constexpr std::size_t k_MaxQuads {4096};
+    static_assert(k_MaxQuads <= GeometryRegistry::k_MaxQuads, "Quads index the shared quad index buffer.");
+
+private:
+
+    Shader m_shader;
+    BitmapFont m_font;
+    GLint m_textureSlot;
+
+    GLuint m_VAO;
+
+    StreamBuffer m_vertexBuffer;
+    std::vector<Vertex> m_vertices;
+    GLsizei m_indexCount; // of the last Upload().
+
+    void AddQuad(glm::vec2 topLeft, glm::vec2 size, const glm::vec4& texRect, std::uint32_t color);
+
+public:
+
+    explicit OverlayBatch(GLint textureSlot);
+    ~OverlayBatch();
+
+    OverlayBatch(const OverlayBatch&)            = delete;
+    OverlayBatch& operator=(const OverlayBatch&) = delete;
+    OverlayBatch(OverlayBatch&&)                 = delete;
+    OverlayBatch& operator=(OverlayBatch&&)      = delete;
+
+    void BeginFrame();
+
+    void AddRect(glm::vec2 topLeft, glm::vec2 size, std::uint32_t color);
+    float AddText(glm::vec2 topLeft, std::string_view text, std::uint32_t color, float scale = 1.0f);
+
+    void Upload(glm::vec2 screenSize);
+    bool IsEmpty() const noexcept;
+    RenderCommand GetCommand() const noexcept;
+};
+}// namespace Renderer
+#endif
@@ -0,0 +1,49 @@
+#ifndef PACKING_H
+#define PACKING_H
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+namespace Renderer
+{
+/*
+* Compact vertex attribute encodings, each read back by GL without shader code:
+* - PackHalf():   GL_HALF_FLOAT, for sizes and offsets, 11 bits of precision up to 65504.
+* - PackUnorm16(): GL_UNSIGNED_SHORT normalized, for texture coordinates in [0, 1].
+* - PackAngle():  GL_SHORT normalized, radians as a fraction of pi; the shader multiplies by pi.
+* World positions stay 32-bit floats, the world is unbounded and halves lose whole pixels past 2048.
+*/
+inline std::uint16_t PackHalf(float value) noexcept
+{
+    return glm::packHalf1x16(value);
+}
+
+inline glm::u16vec2 PackHalf(glm::vec2 value) noexcept
+{
+    return {glm::packHalf1x16(value.x), glm::packHalf1x16(value.y)};
+}
+
+inline std::uint16_t PackUnorm16(float value) noexcept
+{
+    return glm::packUnorm1x16(value);
+}
+
+inline glm::u16vec4 PackUnorm16(const glm::vec4& value) noexcept
+{
+    return {glm::packUnorm1x16(value.x), glm::packUnorm1x16(value.y), glm::packUnorm1x16(value.z), glm::packUnorm1x16(value.w)};
+}
+
+// Wrapped to [-pi, pi) first, so any accumulated rotation keeps full precision.
+inline std::int16_t PackAngle(float radians) noexcept
+{
+    constexpr float pi {std::numbers::pi_v<float>};
+    const float wrapped {radians - 2.0f * pi * std::floor((radians + pi) / (2.0f * pi))};
+    return static_cast<std::int16_t>(glm::packSnorm1x16(wrapped / pi));
+}
+}// namespace Renderer
+#endif
@@ -0,0 +1,232 @@
+#include "renderer/ParticlePool.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GAMENINE_PARTICLES_SSE2 1
+#endif
+
+namespace Renderer
+{
+namespace
+{
+    constexpr std::size_t k_Lanes {4};
+
+    constexpr std::size_t RoundToLanes(std::size_t count) noexcept
+    {
+        return (count + k_Lanes - 1) / k_Lanes * k_Lanes;
+    }
+}// anonymous namespace
+
+ParticlePool::ParticlePool(std::size_t capacity, float damping):
+m_capacity(capacity),
+m_count(0),
+m_positionX(RoundToLanes(capacity)),
+m_positionY(RoundToLanes(capacity)),
+m_velocityX(RoundToLanes(capacity)),
+m_velocityY(RoundToLanes(capacity)),
+m_life(RoundToLanes(capacity)),
+m_alpha(RoundToLanes(capacity)),
+m_fade(RoundToLanes(capacity)),
+m_size(RoundToLanes(capacity)),
+m_growth(RoundToLanes(capacity)),
+m_damping(damping)
+{}
+
+/*
+* Adds a particle, returns false and drops it when the pool is full.
+*/
+bool ParticlePool::Emit(const Particle& particle) noexcept
+{
+    if (m_count == m_capacity || particle.lifetime <= 0.0f)
+    {
+        return false;
+    }
+
+    const auto i {m_count++};
+    m_positionX[i] = particle.position.x;
+    m_positionY[i] = particle.position.y;
+    m_velocityX[i] = particle.velocity.x;
+    m_velocityY[i] = particle.velocity.y;
+    m_life[i]      = particle.lifetime;
+    m_alpha[i]     = particle.alpha;
+    m_fade[i]      = particle.alpha / particle.lifetime;
+    m_size[i]      = particle.size;
+    m_growth[i]    = particle.growth;
+    return true;
+}
+
+/*
+* Advances particles [begin, end), {begin} a multiple of the SIMD width. Lanes past the live count
+* are integrated too, they are padding or dead slots and nobody reads them.
+*/
+void ParticlePool::Integrate(std::size_t begin, std::size_t end, float deltaSeconds, float drag) noexcept
+{
+    std::size_t i {begin};
+
+#ifdef GAMENINE_PARTICLES_SSE2
+    const __m128 dt    {_mm_set1_ps(deltaSeconds)};
+    const __m128 damp  {_mm_set1_ps(drag)};
+    const __m128 zero  {_mm_setzero_ps()};
+
+    for (; i < end; i += k_Lanes)
+    {
+        const __m128 vx {_mm_mul_ps(_mm_loadu_ps(&m_velocityX[i]), damp)};
+        const __m128 vy {_mm_mul_ps(_mm_loadu_ps(&m_velocityY[i]), damp)};
+        _mm_storeu_ps(&m_velocityX[i], vx);
+        _mm_storeu_ps(&m_velocityY[i], vy);
+
+        _mm_storeu_ps(&m_positionX[i], _mm_add_ps(_mm_loadu_ps(&m_positionX[i]), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&m_positionY[i], _mm_add_ps(_mm_loadu_ps(&m_positionY[i]), _mm_mul_ps(vy, dt)));
+
+        _mm_storeu_ps(&m_life[i], _mm_sub_ps(_mm_loadu_ps(&m_life[i]), dt));
+
+        const __m128 alpha {_mm_sub_ps(_mm_loadu_ps(&m_alpha[i]), _mm_mul_ps(_mm_loadu_ps(&m_fade[i]), dt))};
+        _mm_storeu_ps(&m_alpha[i], _mm_max_ps(alpha, zero));
+
+        _mm_storeu_ps(&m_size[i], _mm_add_ps(_mm_loadu_ps(&m_size[i]), _mm_mul_ps(_mm_loadu_ps(&m_growth[i]), dt)));
+    }
+#endif
+
+    for (; i < end; ++i)
+    {
+        m_velocityX[i] *= drag;
+        m_velocityY[i] *= drag;
+        m_positionX[i] += m_velocityX[i] * deltaSeconds;
+        m_positionY[i] += m_velocityY[i] * deltaSeconds;
+        m_life[i]      -= deltaSeconds;
+        m_alpha[i]      = std::max(m_alpha[i] - m_fade[i] * deltaSeconds, 0.0f);
+        m_size[i]      += m_growth[i] * deltaSeconds;
+    }
+}
+
+/*
+* Swaps every expired particle with the last live one.
+*/
+void ParticlePool::RemoveDead() noexcept
+{
+    for (std::size_t i {0}; i < m_count;)
+    {
+        if (m_life[i] > 0.0f)
+        {
+            ++i;
+            continue;
+        }
+
+        const auto last {--m_count};
+        m_positionX[i] = m_positionX[last];
+        m_positionY[i] = m_positionY[last];
+        m_velocityX[i] = m_velocityX[last];
+        m_velocityY[i] = m_velocityY[last];
+        m_life[i]      = m_life[last];
+        m_alpha[i]     = m_alpha[last];
+        m_fade[i]      = m_fade[last];
+        m_size[i]      = m_size[last];
+        m_growth[i]    = m_growth[last];
+    }
+}
+
+/*
+* Integrates every live particle over {deltaSeconds} and removes the expired ones. With more than
+* one worker and enough particles, the arrays are split into contiguous ranges, one per thread.
+*/
+void ParticlePool::Update(float deltaSeconds)
+{
+    if (m_count == 0)
+    {
+        return;
+    }
+
+    const float drag {std::exp(-m_damping * deltaSeconds)};
+    const std::size_t end {RoundToLanes(m_count)};
+
+    if (m_workers && m_count >= k_MinParallelCount)
+    {
+        const std::size_t workers {m_workers->GetWorkerCount()};
+        const std::size_t chunk {RoundToLanes((end + workers - 1) / workers)};
+
+        auto integrate = [&](std::size_t worker)
+        {
+            const std::size_t begin {worker * chunk};
+            if (begin < end)
+            {
+                Integrate(begin, std::min(begin + chunk, end), deltaSeconds, drag);
+            }
+        };
+        m_workers->Run(integrate);
+    }
+    else
+    {
+        Integrate(0, end, deltaSeconds, drag);
+    }
+
+    RemoveDead();
+}
+
+void ParticlePool::Clear() noexcept
+{
+    m_count = 0;
+}
+
+/*
+* Interleaves the live particles into {out}, which must hold GetCount() instances.
+*/
+void ParticlePool::WriteInstances(ParticleInstance* out) const noexcept
+{
+    std::size_t i {0};
+
+#ifdef GAMENINE_PARTICLES_SSE2
+    // Four particles at a time: transposing the four attribute rows gives four instances.
+    for (; i + k_Lanes <= m_count; i += k_Lanes)
+    {
+        __m128 x {_mm_loadu_ps(&m_positionX[i])};
+        __m128 y {_mm_loadu_ps(&m_positionY[i])};
+        __m128 size {_mm_loadu_ps(&m_size[i])};
+        __m128 alpha {_mm_loadu_ps(&m_alpha[i])};
+        _MM_TRANSPOSE4_PS(x, y, size, alpha);
+
+        auto* destination {reinterpret_cast<float*>(out + i)};
+        _mm_storeu_ps(destination + 0,  x);
+        _mm_storeu_ps(destination + 4,  y);
+        _mm_storeu_ps(destination + 8,  size);
+        _mm_storeu_ps(destination + 12, alpha);
+    }
+#endif
+
+    for (; i < m_count; ++i)
+    {
+        out[i] = {{m_positionX[i], m_positionY[i]}, m_size[i], m_alpha[i]};
+    }
+}
+
+/*
+* Threads used by Update(), 1 keeps everything on the calling thread. Starts the extra threads
+* once, they sleep until an Update() has enough particles to split.
+*/
+void ParticlePool::SetWorkerCount(unsigned int workers)
+{
+    workers = std::max(workers, 1u);
+    if (m_workers && m_workers->GetWorkerCount() == workers)
+    {
+        return;
+    }
+
+    m_workers.reset();
+    if (workers > 1)
+    {
+        m_workers = std::make_unique<Utility::WorkerPool>(workers);
+    }
+}
+
+std::size_t ParticlePool::GetCount() const noexcept
+{
+    return m_count;
+}
+
+std::size_t ParticlePool::GetCapacity() const noexcept
+{
+    return m_capacity;
+}
+}// namespace Renderer
@@ -0,0 +1,91 @@
+#ifndef PARTICLEPOOL_H
+#define PARTICLEPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "utility/WorkerPool.h"
+
+namespace Renderer
+{
+// A particle to spawn, see ParticlePool::Emit().
+struct Particle
+{
+    glm::vec2 position {0.0f};
+    glm::vec2 velocity {0.0f};
+    float lifetime {1.0f}; // seconds.
+    float size     {8.0f}; // world units across.
+    float growth   {0.0f}; // size gained per second.
+    float alpha    {1.0f}; // fades linearly to 0 over the lifetime.
+};
+
+// Per-instance data the particle shader reads, written by ParticlePool::WriteInstances().
+struct ParticleInstance
+{
+    glm::vec2 position;
+    float size;
+    float alpha;
+};
+static_assert(sizeof(ParticleInstance) == 16);
+
+/*
+* Fixed-capacity particles stored as structure of arrays, one float array per attribute, so the
+* update integrates four particles per SSE2 instruction (scalar where SSE2 is unavailable). Dead
+* particles are swapped with the last live one; order is not kept and nothing allocates after
+* construction. Optionally the integration is split across a Utility::WorkerPool, whose threads stay
+* parked between frames.
+*/
+class ParticlePool
+{
+private:
+
+    std::size_t m_capacity;
+    std::size_t m_count;
+
+    // Sized to the capacity rounded up to the SIMD width, so the last lanes never read past the end.
+    std::vector<float> m_positionX;
+    std::vector<float> m_positionY;
+    std::vector<float> m_velocityX;
+    std::vector<float> m_velocityY;
+    std::vector<float> m_life;   // seconds left.
+    std::vector<float> m_alpha;
+    std::vector<float> m_fade;   // alpha lost per second.
+    std::vector<float> m_size;
+    std::vector<float> m_growth;
+
+    float m_damping; // fraction of velocity lost per second, exponential.
+
+    std::unique_ptr<Utility::WorkerPool> m_workers; // only with more than one worker.
+
+    void Integrate(std::size_t begin, std::size_t end, float deltaSeconds, float drag) noexcept;
+    void RemoveDead() noexcept;
+
+public:
+
+    // Live particles below this are always updated on the calling thread.
+    static constexpr std::size_t k_MinParallelCount {16384};
+
+    explicit ParticlePool(std::size_t capacity, float damping = 1.5f);
+    ~ParticlePool() = default;
+
+    ParticlePool(const ParticlePool&)            = delete;
+    ParticlePool& operator=(const ParticlePool&) = delete;
+    ParticlePool(ParticlePool&&)                 = delete;
+    ParticlePool& operator=(ParticlePool&&)      = delete;
+
+    bool Emit(const Particle& particle) noexcept;
+    void Update(float deltaSeconds);
+    void Clear() noexcept;
+
+    void WriteInstances(ParticleInstance* out) const noexcept;
+
+    void SetWorkerCount(unsigned int workers);
+
+    std::size_t GetCount() const noexcept;
+    std::size_t GetCapacity() const noexcept;
+};
+}// namespace Renderer
+#endif
@@ -0,0 +1,125 @@
+#include "renderer/ParticleRenderer.h"
+
+#include <cassert>
+#include <filesystem>
+
+#include "renderer/GeometryRegistry.h"
+
+namespace Renderer
+{
+namespace
+{
+    const std::filesystem::path k_VertexShader   {"resources/shaders/particle.vert"};
+    const std::filesystem::path k_FragmentShader {"resources/shaders/particle.frag"};
+}// anonymous namespace
+
+ParticleRenderer::ParticleRenderer(std::size_t capacity, GLint textureSlot):
+m_shader(k_VertexShader, k_FragmentShader),
+m_VAO(0),
+m_instanceBuffer(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(ParticleInstance))),
+m_capacity(capacity),
+m_instanceCount(0),
+m_texture(0),
+m_textureSlot(textureSlot)
+{
+    glGenVertexArrays(1, &m_VAO);
+    glBindVertexArray(m_VAO);
+
+    // Centered quad, scaled per instance.
+    GeometryRegistry::Instance().AttachMesh(Mesh::CenteredQuad, 0);
+
+    // Per-instance attribute, pointed at the frame's stream allocation by Upload().
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_shader.Bind();
+    m_shader.SetUniform1i("u_Atlas", m_textureSlot);
+    m_shader.SetUniform1i("u_Textured", 0);
+    m_shader.SetUniform4f("u_Color", 1.0f, 1.0f, 1.0f, 1.0f);
+    m_shader.UnBind();
+}
+
+ParticleRenderer::~ParticleRenderer()
+{
+    glDeleteVertexArrays(1, &m_VAO);
+}
+
+/*
+* Atlas every particle samples, 0 for plain round particles.
+*/
+void ParticleRenderer::SetTexture(GLuint texture)
+{
+    m_texture = texture;
+
+    m_shader.Bind();
+    m_shader.SetUniform1i("u_Textured", m_texture != 0 ? 1 : 0);
+    m_shader.UnBind();
+}
+
+void ParticleRenderer::SetColor(const glm::vec4& color)
+{
+    m_shader.Bind();
+    m_shader.SetUniform4f("u_Color", color.x, color.y, color.z, color.w);
+    m_shader.UnBind();
+}
+
+/*
+* Streams the pool's particles for this frame, once per frame after the pool was updated.
+*/
+void ParticleRenderer::Upload(const ParticlePool& pool)
+{
+    m_instanceBuffer.BeginFrame();
+
+    assert(pool.GetCapacity() <= m_capacity && "ParticlePool larger than the renderer's instance buffer.");
+
+    const auto count {pool.GetCount()};
+    m_instanceCount = 0;
+    if (count == 0 || count > m_capacity)
+    {
+        return;
+    }
+
+    const auto allocation {m_instanceBuffer.Allocate(static_cast<GLsizeiptr>(count * sizeof(ParticleInstance)))};
+    assert(allocation && "ParticleRenderer uploaded more than once per frame.");
+    if (!allocation)
+    {
+        return;
+    }
+
+    pool.WriteInstances(static_cast<ParticleInstance*>(allocation.data));
+    m_instanceBuffer.Commit(allocation);
+
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer.GetID());
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), reinterpret_cast<const void*>(allocation.offset));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_instanceCount = static_cast<GLsizei>(count);
+}
+
+/*
+* One translucent instanced draw for every uploaded particle.
+*/
+void ParticleRenderer::Submit(RenderQueue& queue, float depth) const
+{
+    if (m_instanceCount == 0)
+    {
+        return;
+    }
+
+    RenderCommand command
+    {
+        .shader        = &m_shader,
+        .texture       = m_texture,
+        .textureSlot   = m_textureSlot,
+        .vertexArray   = m_VAO,
+        .indexCount    = GeometryRegistry::k_IndicesPerQuad,
+        .instanceCount = m_instanceCount,
+    };
+    queue.Submit(command, depth, true);
+}
+}// namespace Renderer
@@ -0,0 +1,53 @@
+#ifndef PARTICLERENDERER_H
+#define PARTICLERENDERER_H
+
+#include <cstddef>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "renderer/ParticlePool.h"
+#include "renderer/RenderQueue.h"
+#include "renderer/Shader.h"
+#include "renderer/StreamBuffer.h"
+
+namespace Renderer
+{
+/*
+* Draws a ParticlePool with one instanced call: a unit quad per particle, placed, sized and faded
+* by its ParticleInstance. Particles sample an atlas texture when one is set, otherwise they are
+* soft round dots. Use one renderer per atlas.
+*/
+class ParticleRenderer
+{
+private:
+
+    Shader m_shader;
+
+    GLuint m_VAO;
+
+    StreamBuffer m_instanceBuffer;
+    std::size_t m_capacity;
+    GLsizei m_instanceCount; // of the last Upload().
+
+    GLuint m_texture;
+    GLint m_textureSlot;
+
+public:
+
+    ParticleRenderer(std::size_t capacity, GLint textureSlot);
+    ~ParticleRenderer();
+
+    ParticleRenderer(const ParticleRenderer&)            = delete;
+    ParticleRenderer& operator=(const ParticleRenderer&) = delete;
+    ParticleRenderer(ParticleRenderer&&)                 = delete;
+    ParticleRenderer& operator=(ParticleRenderer&&)      = delete;
+
+    void SetTexture(GLuint texture);
+    void SetColor(const glm::vec4& color);
+
+    void Upload(const ParticlePool& pool);
+    void Submit(RenderQueue& queue, float depth) const;
+};
+}// namespace Renderer
+#endif
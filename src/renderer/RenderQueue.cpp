@@ -0,0 +1,554 @@
+#include "renderer/RenderQueue.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <optional>
+
+namespace Renderer
+{
+namespace
+{
+    // Texture units tracked while executing, commands using higher units always rebind.
+    constexpr std::size_t k_TrackedSlots {16};
+
+    constexpr std::uint64_t k_StateMask {0xFFF};
+    constexpr std::uint64_t k_TranslucentBit {std::uint64_t{1} << 56};
+
+    /*
+    * Maps a float onto an unsigned integer with the same ordering, negatives included.
+    */
+    std::uint32_t OrderedDepth(float depth) noexcept
+    {
+        const auto bits {std::bit_cast<std::uint32_t>(depth)};
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    std::uint8_t KeyLayer(std::uint64_t key) noexcept
+    {
+        return static_cast<std::uint8_t>(key >> 57);
+    }
+
+    bool IsTranslucent(std::uint64_t key) noexcept
+    {
+        return (key & k_TranslucentBit) != 0;
+    }
+
+    /*
+    * OrderedDepth() of the command, undoing the inversion of translucent keys.
+    */
+    std::uint32_t KeyDepth(std::uint64_t key) noexcept
+    {
+        const auto depth {static_cast<std::uint32_t>(key >> 24)};
+        return IsTranslucent(key) ? ~depth : depth;
+    }
+}// anonymous namespace
+
+RenderQueue::RenderQueue():
+m_layer(0),
+m_coversView(false),
+m_viewRect(0.0f)
+{}
+
+RenderQueue::~RenderQueue() = default;
+
+std::uint64_t RenderQueue::MakeSortKey(std::uint8_t layer, bool translucent, GLuint shader, GLuint texture, float depth) noexcept
+{
+    std::uint64_t key {static_cast<std::uint64_t>(layer & 0x7F) << 57};
+    const std::uint64_t state {((shader & k_StateMask) << 12) | (texture & k_StateMask)};
+
+    if (translucent)
+    {
+        // Back-to-front: invert depth so farther commands sort first.
+        const std::uint64_t inverted {~OrderedDepth(depth)};
+        key |= k_TranslucentBit;
+        key |= inverted << 24;
+    }
+    else
+    {
+        // Front-to-back, the depth test rejects what later opaque commands would have covered.
+        key |= static_cast<std::uint64_t>(OrderedDepth(depth)) << 24;
+    }
+    key |= state;
+
+    return key;
+}
+
+/*
+* Clears last frame's commands; storage is kept so steady-state frames do not allocate.
+*
+* @params
+* viewRect: camera's visible world rectangle, used by the visibility pass.
+*/
+void RenderQueue::Begin(const glm::vec4& viewRect)
+{
+    m_commands.clear();
+    m_sprites.clear();
+    m_keys.clear();
+    m_indices.clear();
+    m_transforms.clear();
+
+    if (m_spriteBatch)
+    {
+        m_spriteBatch->BeginFrame();
+    }
+
+    m_layer      = 0;
+    m_stats      = RenderStats{};
+    m_coversView = false;
+    m_viewRect   = viewRect;
+}
+
+/*
+* Layer applied to commands submitted from now on, lower layers are drawn first.
+*/
+void RenderQueue::SetLayer(std::uint8_t layer) noexcept
+{
+    assert(layer < 128 && "RenderQueue supports 128 layers.");
+    m_layer = layer;
+}
+
+const glm::vec4& RenderQueue::GetViewRect() const noexcept
+{
+    return m_viewRect;
+}
+
+/*
+* Rectangle overlap test against the frame's view, touching edges count as visible.
+*/
+bool RenderQueue::IsVisible(const glm::vec4& bounds) const noexcept
+{
+    return bounds.x <= m_viewRect.z && bounds.z >= m_viewRect.x &&
+           bounds.y <= m_viewRect.w && bounds.w >= m_viewRect.y;
+}
+
+/*
+* Same as IsVisible() and records the result in the frame's stats; returns true when visible.
+*/
+bool RenderQueue::Cull(const glm::vec4& bounds) noexcept
+{
+    const bool visible {IsVisible(bounds)};
+    RecordVisibility(visible ? 1 : 0, visible ? 0 : 1);
+    return visible;
+}
+
+/*
+* For components that test their instances themselves, ex. instanced tiles.
+*/
+void RenderQueue::RecordVisibility(std::uint32_t visible, std::uint32_t culled) noexcept
+{
+    m_stats.visible += visible;
+    m_stats.culled  += culled;
+}
+
+/*
+* @params
+* command: draw to record, its shader must outlive the frame.
+* depth: distance from the viewer, larger is farther.
+* translucent: blended command, drawn after the layer's opaque commands.
+*
+* Commands with no instances draw nothing and are dropped.
+*/
+void RenderQueue::Submit(const RenderCommand& command, float depth, bool translucent)
+{
+    assert(command.shader && command.vertexArray);
+    if (command.instanceCount <= 0)
+    {
+        return;
+    }
+
+    const auto index {static_cast<std::uint32_t>(m_commands.size())};
+    m_commands.push_back(command);
+    m_keys.push_back(MakeSortKey(m_layer, translucent, command.shader->GetID(), command.texture, depth));
+    m_indices.push_back(index);
+
+    m_coversView = m_coversView || (command.coversView && !translucent);
+    ++m_stats.commands;
+}
+
+/*
+* Same as above, {model} is uploaded to the shader's 'uniform vec3 u_Model[2]' before drawing.
+*/
+void RenderQueue::Submit(RenderCommand command, const Affine2D& model, float depth, bool translucent)
+{
+    if (command.instanceCount <= 0)
+    {
+        return;
+    }
+
+    command.transform = static_cast<std::uint32_t>(m_transforms.size());
+    m_transforms.push_back(model);
+
+    Submit(command, depth, translucent);
+}
+
+/*
+* Queues a textured quad, drawn together with the sprites next to it in sort order.
+*/
+void RenderQueue::SubmitSprite(const Sprite& sprite, float depth, bool translucent)
+{
+    if (!m_spriteBatch)
+    {
+        m_spriteBatch = std::make_unique<SpriteBatch>();
+        m_spriteBatch->BeginFrame();
+    }
+
+    const auto index {static_cast<std::uint32_t>(m_sprites.size())};
+    m_sprites.push_back(sprite);
+    m_keys.push_back(MakeSortKey(m_layer, translucent, m_spriteBatch->GetShader().GetID(), 0, depth));
+    m_indices.push_back(index | k_SpriteBit);
+
+    ++m_stats.commands;
+}
+
+/*
+* Gives every sorted command its depth buffer value in m_depths, as NDC z. Distinct (layer, depth)
+* pairs are ranked back-to-front across the whole frame, so a higher layer is always in front of
+* a lower one, and the ranks are spread evenly over (-1, 1); commands sharing a depth share a z.
+* Within a layer the opaque run is front-to-back and the translucent run back-to-front, the two are
+* merged to rank them together.
+*/
+void RenderQueue::AssignDepths()
+{
+    const std::size_t count {m_keys.size()};
+    m_depths.resize(count);
+
+    std::uint32_t level {0};
+    for (std::size_t begin {0}; begin < count;)
+    {
+        const auto layer {KeyLayer(m_keys[begin])};
+
+        std::size_t split {begin};
+        while (split < count && KeyLayer(m_keys[split]) == layer && !IsTranslucent(m_keys[split]))
+        {
+            ++split;
+        }
+        std::size_t end {split};
+        while (end < count && KeyLayer(m_keys[end]) == layer)
+        {
+            ++end;
+        }
+
+        // Opaque walks down from split, translucent up from it; the farther of the two goes next.
+        std::size_t opaque {split};
+        std::size_t translucent {split};
+        std::optional<std::uint32_t> previous;
+        while (opaque > begin || translucent < end)
+        {
+            const bool takeOpaque {translucent == end ||
+                (opaque > begin && KeyDepth(m_keys[opaque - 1]) >= KeyDepth(m_keys[translucent]))};
+            const std::size_t i {takeOpaque ? --opaque : translucent++};
+
+            const auto depth {KeyDepth(m_keys[i])};
+            if (previous != depth)
+            {
+                ++level;
+                previous = depth;
+            }
+            m_depths[i] = static_cast<float>(level);
+        }
+
+        begin = end;
+    }
+
+    // Farthest level 1 lands near 1, the nearest near -1; a 24-bit buffer tells 2^23 levels apart.
+    const float scale {2.0f / static_cast<float>(level + 1)};
+    for (auto& depth: m_depths)
+    {
+        depth = 1.0f - depth * scale;
+    }
+}
+
+/*
+* Sorts the frame's commands and issues them, only changing GL state when it differs from the
+* previous command. Runs of sprites are batched, a batch is drawn when the run ends or it has no
+* texture unit left.
+*
+* Every command is depth tested against the value AssignDepths() gave it, shaders write it as
+* their z ('u_Depth', or the sprite instance depth). Opaque commands draw front-to-back with depth
+* writes on and blending off, translucent ones back-to-front with depth writes off and blending on.
+* Blending is left enabled and the depth test disabled afterwards.
+*/
+void RenderQueue::Execute()
+{
+    // Stable: commands with equal keys, ex. boats at the same y, keep their submission order, so
+    // overlapping sprites do not swap from one frame to the next.
+    Utility::RadixSortPairs(m_keys, m_indices, m_sortScratch, m_sortPool.get());
+    AssignDepths();
+
+    // An opaque command covering the view hides every lower layer, skipped from the start of the
+    // highest layer holding one. Farther commands of that layer are left to the depth test.
+    std::size_t first {0};
+    if (m_coversView)
+    {
+        for (std::size_t i {m_indices.size()}; i-- > 0;)
+        {
+            const auto index {m_indices[i]};
+            if (!IsTranslucent(m_keys[i]) && !(index & k_SpriteBit) && m_commands[index].coversView)
+            {
+                first = i;
+                while (first > 0 && KeyLayer(m_keys[first - 1]) == KeyLayer(m_keys[i]))
+                {
+                    --first;
+                }
+                break;
+            }
+        }
+        m_stats.occluded = static_cast<std::uint32_t>(first);
+    }
+
+    const Shader* boundShader {nullptr};
+    GLuint boundVertexArray   {0};
+    UniformHandle modelUniform;
+    UniformHandle depthUniform;
+    bool modelResolved {false};
+    bool depthResolved {false};
+
+    std::array<GLuint, k_TrackedSlots> boundTextures;
+    boundTextures.fill(std::numeric_limits<GLuint>::max());
+
+    auto bindTexture = [&](GLuint texture, GLint textureSlot)
+    {
+        const auto slot {static_cast<std::size_t>(textureSlot)};
+        if (slot >= k_TrackedSlots || boundTextures[slot] != texture)
+        {
+            glActiveTexture(GL_TEXTURE0 + textureSlot);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            if (slot < k_TrackedSlots)
+            {
+                boundTextures[slot] = texture;
+            }
+            ++m_stats.textureChanges;
+        }
+    };
+
+    auto bindShader = [&](const Shader* shader)
+    {
+        if (shader != boundShader)
+        {
+            shader->Bind();
+            boundShader   = shader;
+            modelResolved = false;
+            depthResolved = false;
+            ++m_stats.shaderChanges;
+        }
+    };
+
+    auto drawSprites = [&]()
+    {
+        if (!m_spriteBatch || m_spriteBatch->IsEmpty())
+        {
+            return;
+        }
+
+        bindShader(&m_spriteBatch->GetShader());
+
+        const auto textures {m_spriteBatch->GetTextures()};
+        for (std::size_t unit {0}; unit < textures.size(); ++unit)
+        {
+            bindTexture(textures[unit], static_cast<GLint>(unit));
+        }
+
+        if (boundVertexArray != m_spriteBatch->GetVertexArray())
+        {
+            boundVertexArray = m_spriteBatch->GetVertexArray();
+            ++m_stats.vertexArrayChanges;
+        }
+
+        m_spriteBatch->Draw();
+        ++m_stats.drawCalls;
+    };
+
+    if (m_overdraw)
+    {
+        m_overdraw->Begin();
+    }
+    std::optional<std::uint8_t> layer;
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL); // translucent commands at an opaque command's depth still show.
+
+    // Blending and depth writes are per pass: opaque commands write depth and overwrite what is
+    // below them, translucent ones blend and leave depth alone.
+    std::optional<bool> blending;
+    for (std::size_t i {first}; i < m_indices.size(); ++i)
+    {
+        const auto commandLayer {KeyLayer(m_keys[i])};
+        if (m_overdraw && layer != commandLayer)
+        {
+            drawSprites();
+            if (layer)
+            {
+                m_overdraw->EndLayer(*layer);
+            }
+            layer = commandLayer;
+        }
+
+        const bool translucent {IsTranslucent(m_keys[i])};
+        if (blending != translucent)
+        {
+            // Queued sprites are drawn with the state they were sorted under.
+            drawSprites();
+            if (translucent)
+            {
+                glEnable(GL_BLEND);
+                glDepthMask(GL_FALSE);
+            }
+            else
+            {
+                glDisable(GL_BLEND);
+                glDepthMask(GL_TRUE);
+            }
+            blending = translucent;
+        }
+
+        const std::uint32_t index {m_indices[i]};
+        if (index & k_SpriteBit)
+        {
+            const auto& sprite {m_sprites[index & ~k_SpriteBit]};
+            if (!m_spriteBatch->Add(sprite, m_depths[i]))
+            {
+                drawSprites();
+                m_spriteBatch->Add(sprite, m_depths[i]);
+            }
+            continue;
+        }
+        drawSprites();
+
+        const auto& command {m_commands[index]};
+
+        bindShader(command.shader);
+
+        if (command.texture != 0)
+        {
+            bindTexture(command.texture, command.textureSlot);
+        }
+
+        if (command.auxTexture != 0)
+        {
+            bindTexture(command.auxTexture, command.auxTextureSlot);
+        }
+
+        if (command.vertexArray != boundVertexArray)
+        {
+            glBindVertexArray(command.vertexArray);
+            boundVertexArray = command.vertexArray;
+            ++m_stats.vertexArrayChanges;
+        }
+
+        if (command.transform != RenderCommand::k_NoTransform)
+        {
+            if (!modelResolved)
+            {
+                modelUniform  = boundShader->GetUniformHandle("u_Model");
+                modelResolved = true;
+            }
+            boundShader->SetUniform3fv(modelUniform, 2, &m_transforms[command.transform].x.x);
+        }
+        if (!depthResolved)
+        {
+            depthUniform  = boundShader->GetUniformHandle("u_Depth");
+            depthResolved = true;
+        }
+        boundShader->SetUniform1f(depthUniform, m_depths[i]);
+
+        if (command.instanceCount > 1)
+        {
+            glDrawElementsInstanced(GL_TRIANGLES, command.indexCount, GL_UNSIGNED_INT, nullptr, command.instanceCount);
+        }
+        else
+        {
+            glDrawElements(GL_TRIANGLES, command.indexCount, GL_UNSIGNED_INT, nullptr);
+        }
+        ++m_stats.drawCalls;
+    }
+    drawSprites();
+
+    glDepthMask(GL_TRUE);
+    glDisable(GL_DEPTH_TEST);
+
+    if (m_overdraw)
+    {
+        if (layer)
+        {
+            m_overdraw->EndLayer(*layer);
+        }
+        m_overdraw->End();
+        m_overdraw->DrawHeatmap();
+    }
+
+    glBindVertexArray(0);
+    glUseProgram(0);
+    glEnable(GL_BLEND);
+}
+
+/*
+* Releases GPU objects owned by the queue, call while the context is still alive.
+*/
+void RenderQueue::Shutdown()
+{
+    m_spriteBatch.reset();
+    m_overdraw.reset();
+}
+
+/*
+* Debug mode: counts how many times every pixel is shaded per layer and draws the frame as a
+* heatmap of the counts instead of the scene, see OverdrawCounter.
+*/
+void RenderQueue::SetOverdrawCounting(bool enabled)
+{
+    if (enabled && !m_overdraw)
+    {
+        m_overdraw = std::make_unique<OverdrawCounter>();
+    }
+    else if (!enabled)
+    {
+        m_overdraw.reset();
+    }
+}
+
+bool RenderQueue::IsCountingOverdraw() const noexcept
+{
+    return m_overdraw != nullptr;
+}
+
+/*
+* Counts of the last executed frame, nullptr while not counting.
+*/
+const OverdrawCounter* RenderQueue::GetOverdraw() const noexcept
+{
+    return m_overdraw.get();
+}
+
+/*
+* True when an opaque command submitted this frame fills the view, the frame needs no colour clear.
+*/
+bool RenderQueue::CoversView() const noexcept
+{
+    return m_coversView;
+}
+
+/*
+* Threads the sort may use once a frame has Utility::k_MinParallelSortCount commands, 1 keeps it on
+* the calling thread. The extra threads are started here and stay parked between frames.
+*/
+void RenderQueue::SetSortWorkerCount(unsigned int workers)
+{
+    workers = std::max(workers, 1u);
+    if (m_sortPool && m_sortPool->GetWorkerCount() == workers)
+    {
+        return;
+    }
+
+    m_sortPool.reset();
+    if (workers > 1)
+    {
+        m_sortPool = std::make_unique<Utility::WorkerPool>(workers);
+    }
+}
+
+const RenderStats& RenderQueue::GetStats() const noexcept
+{
+    return m_stats;
+}
+}// namespace Renderer
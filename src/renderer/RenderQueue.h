@@ -0,0 +1,149 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "renderer/Affine2D.h"
+#include "renderer/OverdrawCounter.h"
+#include "renderer/Shader.h"
+#include "renderer/SpriteBatch.h"
+#include "utility/RadixSort.h"
+#include "utility/WorkerPool.h"
+
+namespace Renderer
+{
+// A single indexed draw (GL_TRIANGLES, GLuint indices) and the state it needs.
+struct RenderCommand
+{
+    const Shader* shader  {nullptr};
+    GLuint texture        {0};
+    GLint textureSlot     {0};
+    GLuint vertexArray    {0};
+    GLsizei indexCount    {0};
+    GLsizei instanceCount {1};
+
+    // Optional second texture, not part of the sort key, ex. a tilemap's index texture.
+    GLuint auxTexture     {0};
+    GLint auxTextureSlot  {0};
+
+    // Opaque and fills the whole view: nothing in a lower layer can show, see RenderQueue::Execute.
+    bool coversView       {false};
+
+    // Index into the frame's transforms uploaded as 'u_Model', set by RenderQueue::Submit.
+    std::uint32_t transform {k_NoTransform};
+
+    static constexpr std::uint32_t k_NoTransform {std::numeric_limits<std::uint32_t>::max()};
+};
+
+// Per-frame counters, reset by RenderQueue::Begin().
+struct RenderStats
+{
+    std::uint32_t commands       {0};
+    std::uint32_t drawCalls      {0};
+    std::uint32_t shaderChanges  {0};
+    std::uint32_t textureChanges {0};
+    std::uint32_t vertexArrayChanges {0};
+
+    // Visibility pass: sprites or instances inside the view and those skipped.
+    std::uint32_t visible {0};
+    std::uint32_t culled  {0};
+
+    // Commands skipped because a later opaque command covers the whole view.
+    std::uint32_t occluded {0};
+};
+
+/*
+* Per-frame command buffer. Components submit draw commands while the layer stack is traversed,
+* then the commands are radix-sorted on a 64-bit key and executed with redundant shader, texture
+* and vertex array binds skipped; scene traversal order no longer dictates GL submission order.
+*
+* Sort key, most significant bits first:
+*   layer (7) | translucent (1) | depth (32) | shader (12) | texture (12)
+* Within a layer opaque commands come first, front-to-back so the depth test rejects hidden
+* fragments early; translucent commands follow back-to-front so blending stays correct. Commands
+* at the same depth are grouped by state. Larger depth means farther away; boats pass their y,
+* which y-sorts them. Every command is drawn at a depth buffer value ranked from its layer and
+* depth, higher layers in front. The sort is stable, equal keys keep submission order from frame
+* to frame, and splits across threads for large frames (SetSortWorkerCount()).
+*
+* Opaque commands draw with blending off. Lower layers than one holding an opaque command that
+* covers the view are hidden and skipped, and when such a command exists the frame needs no colour clear.
+*
+* Sprites sort with the sprite batch's shader and no texture, so neighbouring sprites stay together
+* whatever their textures; each run of sprites is drawn through SpriteBatch, one draw per
+* SpriteBatch::k_MaxTextureUnits distinct textures.
+*/
+class RenderQueue
+{
+private:
+
+    static constexpr std::uint32_t k_SpriteBit {0x80000000u};
+
+    std::vector<RenderCommand> m_commands;
+    std::vector<Sprite> m_sprites;
+
+    // Sort keys and the command each one draws, kept as parallel arrays for the radix sort. An
+    // index with k_SpriteBit set points into m_sprites instead.
+    std::vector<std::uint64_t> m_keys;
+    std::vector<std::uint32_t> m_indices;
+    Utility::RadixSortScratch<std::uint64_t, std::uint32_t> m_sortScratch;
+    std::vector<float> m_depths; // NDC z of each sorted command, see AssignDepths().
+    std::unique_ptr<Utility::WorkerPool> m_sortPool; // only with more than one sort worker.
+    std::vector<Affine2D> m_transforms;
+
+    std::uint8_t m_layer;
+    RenderStats m_stats;
+    bool m_coversView; // an opaque command fills the view this frame.
+
+    // Visible world rectangle {left, bottom, right, top} for the frame.
+    glm::vec4 m_viewRect;
+
+    // Created with the first sprite, a GL context is needed.
+    std::unique_ptr<SpriteBatch> m_spriteBatch;
+
+    // Set while overdraw is being measured, see SetOverdrawCounting().
+    std::unique_ptr<OverdrawCounter> m_overdraw;
+
+    void AssignDepths();
+
+    static std::uint64_t MakeSortKey(std::uint8_t layer, bool translucent, GLuint shader, GLuint texture, float depth) noexcept;
+
+public:
+
+    RenderQueue();
+    ~RenderQueue();
+
+    void Begin(const glm::vec4& viewRect);
+    void SetLayer(std::uint8_t layer) noexcept;
+
+    // Visibility pass, bounds are {left, bottom, right, top} in world space.
+    const glm::vec4& GetViewRect() const noexcept;
+    bool IsVisible(const glm::vec4& bounds) const noexcept;
+    bool Cull(const glm::vec4& bounds) noexcept;
+    void RecordVisibility(std::uint32_t visible, std::uint32_t culled) noexcept;
+
+    void Submit(const RenderCommand& command, float depth, bool translucent = true);
+    void Submit(RenderCommand command, const Affine2D& model, float depth, bool translucent = true);
+    void SubmitSprite(const Sprite& sprite, float depth, bool translucent = true);
+
+    void Execute();
+    void Shutdown();
+
+    void SetSortWorkerCount(unsigned int workers);
+
+    void SetOverdrawCounting(bool enabled);
+    bool IsCountingOverdraw() const noexcept;
+    const OverdrawCounter* GetOverdraw() const noexcept;
+
+    bool CoversView() const noexcept;
+    const RenderStats& GetStats() const noexcept;
+};
+}// namespace Renderer
+#endif
@@ -1,74 +1,105 @@
 #include "renderer/Shader.h"
 
+#include <algorithm>
+#include <cassert>
 #include <print>
 #include <cstdio>
 #include <stdexcept>
 #include <string>
-#include <fstream>
+#include <ios>
 
 #include <GL/glew.h>
 
+#include "renderer/CameraBuffer.h"
+#include "renderer/ShaderCache.h"
+#include "utility/ResourcePack.h"
+
 namespace Renderer
 {
 /*
- * Parse and Compile Shader.
+ * Parse and Compile Shader. A program binary cached by a previous run is used when available,
+ * otherwise the stages are compiled (or reused from the in-process ShaderCache) and linked.
  */
 Shader::Shader(const std::filesystem::path& vertex, const std::filesystem::path& fragment)
 {
-    auto vertexID   = CompileShader(GL_VERTEX_SHADER, ParseShaderFile(vertex));
-    auto fragmentID = CompileShader(GL_FRAGMENT_SHADER, ParseShaderFile(fragment));
+    const auto vertexSource   = ParseShaderFile(vertex);
+    const auto fragmentSource = ParseShaderFile(fragment);
 
     if (m_programID = glCreateProgram(); !m_programID)
     {
         throw std::runtime_error("glCreateProgram failed.");
     }
 
-    glAttachShader(m_programID, vertexID);
-    glAttachShader(m_programID, fragmentID);
-    glLinkProgram(m_programID);
-
-    glValidateProgram(m_programID);
+    auto& cache {ShaderCache::Instance()};
+    const auto programKey {cache.ProgramKey(vertexSource, fragmentSource)};
 
-    int linkStatus;
-    glGetProgramiv(m_programID, GL_LINK_STATUS, &linkStatus);
-    if (linkStatus == GL_FALSE)
+    if (!cache.LoadProgram(m_programID, programKey))
     {
-        int loglength;
-        glGetProgramiv(m_programID, GL_INFO_LOG_LENGTH, &loglength);
+        unsigned int vertexID   {};
+        unsigned int fragmentID {};
+        try
+        {
+            vertexID   = cache.GetStage(GL_VERTEX_SHADER, vertexSource);
+            fragmentID = cache.GetStage(GL_FRAGMENT_SHADER, fragmentSource);
+        }
+        catch (...)
+        {
+            glDeleteProgram(m_programID);
+            throw;
+        }
 
-        std::string message(loglength, '\0');
-        glGetProgramInfoLog(m_programID, 1024, &loglength, message.data());
+        // Stage objects are owned by the cache, detach rather than delete.
+        glAttachShader(m_programID, vertexID);
+        glAttachShader(m_programID, fragmentID);
+        cache.PrepareProgram(m_programID);
+        glLinkProgram(m_programID);
+        glDetachShader(m_programID, vertexID);
+        glDetachShader(m_programID, fragmentID);
+
+        int linkStatus;
+        glGetProgramiv(m_programID, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus == GL_FALSE)
+        {
+            int loglength;
+            glGetProgramiv(m_programID, GL_INFO_LOG_LENGTH, &loglength);
 
-        glDeleteShader(vertexID);
-        glDeleteShader(fragmentID);
+            std::string message(loglength, '\0');
+            glGetProgramInfoLog(m_programID, loglength, &loglength, message.data());
+
+            glDeleteProgram(m_programID);
 
-        throw std::runtime_error(std::string{"Program failed to link/validate: "} + message);
+            throw std::runtime_error(std::string{"Program failed to link/validate: "} + message);
+        }
+
+        cache.StoreProgram(m_programID, programKey);
     }
 
-    glDeleteShader(vertexID);
-    glDeleteShader(fragmentID);
-}
+    glValidateProgram(m_programID);
 
-Shader::~Shader()
-{
-    if (m_programID != 0)
+    ReflectUniforms();
+
+    // Programs that read the camera share a single uniform buffer.
+    if (auto blockIndex = glGetUniformBlockIndex(m_programID, "Camera"); blockIndex != GL_INVALID_INDEX)
     {
-        glDeleteProgram(m_programID);
+        glUniformBlockBinding(m_programID, blockIndex, k_CameraBindingPoint);
     }
 }
 
-Shader::Shader(Shader&& other) noexcept
+Shader::~Shader()
 {
     if (m_programID != 0)
     {
         glDeleteProgram(m_programID);
     }
+}
 
-    m_programID            = other.m_programID;
-    m_uniformLocationCache = std::move(other.m_uniformLocationCache);
-
+Shader::Shader(Shader&& other) noexcept:
+m_programID(other.m_programID),
+m_uniforms(std::move(other.m_uniforms)),
+m_missingUniforms(std::move(other.m_missingUniforms))
+{
     other.m_programID = 0;
-    other.m_uniformLocationCache.clear();
+    other.m_uniforms.clear();
 }
 
 Shader& Shader::operator=(Shader&& other) noexcept
@@ -80,43 +111,29 @@ Shader& Shader::operator=(Shader&& other) noexcept
             glDeleteProgram(m_programID);
         }
 
-        m_programID            = other.m_programID;
-        m_uniformLocationCache = std::move(other.m_uniformLocationCache);
+        m_programID       = other.m_programID;
+        m_uniforms        = std::move(other.m_uniforms);
+        m_missingUniforms = std::move(other.m_missingUniforms);
 
         other.m_programID = 0;
-        other.m_uniformLocationCache.clear();
+        other.m_uniforms.clear();
     }
 
     return *this;
 }
 
 /*
-* Reads contents from file and returns as a string.
+* Reads contents from the mounted resource pack, or from file, and returns as a string.
 */
 std::string Shader::ParseShaderFile(const std::filesystem::path& filepath)
 {
-    std::ifstream ifs(filepath, std::ios_base::in | std::ios_base::binary);
-    if (!ifs)
-    {
-        throw std::ios_base::failure(std::format("Failed to open file for reading: {}", filepath.string()));
-    }
-
-    std::string contents;
-
-    std::error_code ec;
-    if (const auto size = std::filesystem::file_size(filepath, ec); !ec)
-    {
-        contents.reserve(static_cast<size_t>(size));
-    }
-
-    std::array<char, 1024> buffer;
-    while (ifs.read(buffer.data(), buffer.size()))
+    const auto resource {Utility::ReadResource(filepath)};
+    if (!resource)
     {
-        contents.append(buffer.data(), buffer.size());
+        throw std::ios_base::failure(resource.error());
     }
-    contents.append(buffer.data(), ifs.gcount());
 
-    return contents;
+    return std::string{resource->GetText()};
 }
 
 /*
@@ -143,8 +160,7 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
         int length;
         glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
 
-        std::string message;
-        message.reserve(length);
+        std::string message(length, '\0');
         glGetShaderInfoLog(id, length, &length, message.data());
 
         glDeleteShader(id);
@@ -173,76 +189,161 @@ void Shader::UnBind() const
     glUseProgram(0);
 }
 
-// looks up uniform in cache, if not found does a expensive glGetUniformLocation() look up.
-int Shader::GetUniformLocation(const std::string& name) const
+/*
+ * Enumerates active uniforms once after linking; lookups afterwards are a binary search over
+ * compile-time hashes. Uniform block members have no location and are skipped.
+ */
+void Shader::ReflectUniforms()
+{
+    int count {0};
+    int maxLength {0};
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    m_uniforms.clear();
+    m_uniforms.reserve(count);
+
+    std::string buffer(maxLength, '\0');
+    for (int i {0}; i < count; ++i)
+    {
+        GLsizei length {0};
+        GLint size     {0};
+        GLenum type    {0};
+        glGetActiveUniform(m_programID, i, maxLength, &length, &size, &type, buffer.data());
+
+        int location {glGetUniformLocation(m_programID, buffer.c_str())};
+        if (location == -1)
+        {
+            continue;
+        }
+
+        // Arrays are reported as 'name[0]', store them under their base name.
+        std::string_view name(buffer.data(), length);
+        if (name.ends_with("[0]"))
+        {
+            name.remove_suffix(3);
+        }
+
+        m_uniforms.push_back({Utility::Fnv1a32(name), {location, type}});
+    }
+
+    std::ranges::sort(m_uniforms, {}, &UniformInfo::hash);
+    if (std::ranges::adjacent_find(m_uniforms, {}, &UniformInfo::hash) != m_uniforms.end())
+    {
+        std::println(stderr, "Shader {}: uniform name hash collision, rename a uniform.", m_programID);
+    }
+}
+
+/*
+ * Resolves a uniform name to its handle, meant to be called once and the handle kept. A missing
+ * uniform is reported the first time it is requested and an invalid handle is returned.
+ */
+UniformHandle Shader::GetUniformHandle(Uniform name) const
 {
-    auto it = m_uniformLocationCache.find(name);
-    if (it != m_uniformLocationCache.end())
-        return it->second;
+    auto iter = std::ranges::lower_bound(m_uniforms, name.hash, {}, &UniformInfo::hash);
+    if (iter != m_uniforms.end() && iter->hash == name.hash)
+    {
+        return iter->handle;
+    }
 
-    int uLocation{glGetUniformLocation(m_programID, name.c_str())};
-    if (uLocation != -1)
-        m_uniformLocationCache[name] = uLocation;
+    if (std::ranges::find(m_missingUniforms, name.hash) == m_missingUniforms.end())
+    {
+        m_missingUniforms.push_back(name.hash);
+        std::println(stderr, "Shader {}: uniform '{}' not found or inactive.", m_programID, name.name);
+    }
 
-    return uLocation;
+    return UniformHandle{};
 }
 
 // glUniform1i and glUniform1iv are the only two functions that may be used to load uniform variables defined as sampler types.
-void Shader::SetUniform1i(const std::string& name, int value) const
+void Shader::SetUniform1i(Uniform name, int value) const
 {
-    int var_location{GetUniformLocation(name)};
-    if (var_location <= -1)
-        std:println(stderr, "SetUniform1i: Variable {} Location Not Found", name);
-
-    glUniform1i(var_location, value);
+    SetUniform1i(GetUniformHandle(name), value);
 }
 
-void Shader::SetUniform1iv(const std::string& name, int count, int* value) const
+void Shader::SetUniform1iv(Uniform name, int count, const int* value) const
 {
-    int var_location{GetUniformLocation(name)};
-    if (var_location <= -1)
-        std::println(stderr, "SetUniform1iv: Variable {} Location Not Found", name);
+    SetUniform1iv(GetUniformHandle(name), count, value);
+}
 
-    glUniform1iv(var_location, count, value);
+void Shader::SetUniform2i(Uniform name, int v0, int v1) const
+{
+    SetUniform2i(GetUniformHandle(name), v0, v1);
 }
 
-void Shader::SetUniform1f(const std::string& name, float value) const
+void Shader::SetUniform1f(Uniform name, float value) const
 {
-    int var_location{GetUniformLocation(name)};
-    if (var_location <= -1)
-        std::println(stderr, "SetUniform1f: Variable {} Location Not Found", name);
+    SetUniform1f(GetUniformHandle(name), value);
+}
 
-    glUniform1f(var_location, value);
+void Shader::SetUniform2f(Uniform name, float v0, float v1) const
+{
+    SetUniform2f(GetUniformHandle(name), v0, v1);
 }
 
 /*
 * Upload three contigous floats in an array. Takes a {count} amount of glm::vec3, float [3],
 * float[3*x].
 */
-void Shader::SetUniform3fv(const std::string& name, const int count, const GLfloat* value) const
+void Shader::SetUniform3fv(Uniform name, const int count, const GLfloat* value) const
 {
-    int var_location{GetUniformLocation(name)};
-    if (var_location <= -1)
-        std::println(stderr, "SetUniform3fv: Variable {} Location Not Found", name);
+    SetUniform3fv(GetUniformHandle(name), count, value);
+}
 
-    glUniform3fv(var_location, count, value);
+void Shader::SetUniform4f(Uniform name, float v0, float v1, float v2, float v3) const
+{
+    SetUniform4f(GetUniformHandle(name), v0, v1, v2, v3);
+}
+
+void Shader::SetUniformMat4f(Uniform name, const glm::mat4& matrix) const
+{
+    SetUniformMat4f(GetUniformHandle(name), matrix);
+}
+
+// An invalid handle has location -1, which glUniform* silently ignores.
+void Shader::SetUniform1i(UniformHandle handle, int value) const
+{
+    glUniform1i(handle.location, value);
+}
+
+void Shader::SetUniform1iv(UniformHandle handle, int count, const int* value) const
+{
+    glUniform1iv(handle.location, count, value);
 }
 
-void Shader::SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3) const
+void Shader::SetUniform2i(UniformHandle handle, int v0, int v1) const
 {
-    int var_location{GetUniformLocation(name)};
-    if (var_location <= -1)
-        std::println(stderr, "SetUniform4f: Variable {} Location Not Found", name);
+    assert(!handle.IsValid() || handle.type == GL_INT_VEC2);
+    glUniform2i(handle.location, v0, v1);
+}
+
+void Shader::SetUniform1f(UniformHandle handle, float value) const
+{
+    assert(!handle.IsValid() || handle.type == GL_FLOAT);
+    glUniform1f(handle.location, value);
+}
+
+void Shader::SetUniform2f(UniformHandle handle, float v0, float v1) const
+{
+    assert(!handle.IsValid() || handle.type == GL_FLOAT_VEC2);
+    glUniform2f(handle.location, v0, v1);
+}
 
-    glUniform4f(var_location, v0, v1, v2, v3);
+void Shader::SetUniform3fv(UniformHandle handle, const int count, const GLfloat* value) const
+{
+    assert(!handle.IsValid() || handle.type == GL_FLOAT_VEC3);
+    glUniform3fv(handle.location, count, value);
 }
 
-void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix) const
+void Shader::SetUniform4f(UniformHandle handle, float v0, float v1, float v2, float v3) const
 {
-    int var_location{GetUniformLocation(name)};
-    if (var_location <= -1)
-        std::println(stderr, "SetUniformMat4f: Variable {} Location Not Found", name);
+    assert(!handle.IsValid() || handle.type == GL_FLOAT_VEC4);
+    glUniform4f(handle.location, v0, v1, v2, v3);
+}
 
-    glUniformMatrix4fv(var_location, 1, GL_FALSE, &matrix[0][0]);
+void Shader::SetUniformMat4f(UniformHandle handle, const glm::mat4& matrix) const
+{
+    assert(!handle.IsValid() || handle.type == GL_FLOAT_MAT4);
+    glUniformMatrix4fv(handle.location, 1, GL_FALSE, &matrix[0][0]);
 }
 }// namespace Renderer
@@ -1,14 +1,40 @@
 #ifndef SHADER_H
 #define SHADER_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <filesystem>
-#include <unordered_map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
+#include "utility/Hash.h"
+
 namespace Renderer
 {
+// Uniform name hashed at compile time (FNV-1a), string literals convert implicitly so
+// call sites such as SetUniformMat4f("u_Model", ...) neither allocate nor hash at runtime.
+struct Uniform
+{
+    std::uint32_t hash;
+    std::string_view name;
+
+    template<std::size_t N>
+    consteval Uniform(const char (&str)[N]):
+    hash(Utility::Fnv1a32({str, N - 1})), name(str, N - 1)
+    {}
+};
+
+// Uniform location and GL type resolved once from the program's active uniforms.
+struct UniformHandle
+{
+    int location       {-1};
+    unsigned int type  {0};
+
+    bool IsValid() const noexcept {return location != -1;}
+};
+
 // Shaders are software that run on the GPU, this class takes
 // two types of shaders Vertex shader (runs once per vertex) and
 // Fragment shader (runs per pixel). This class parses, and compiles the
@@ -23,8 +49,19 @@ private:
     // (vertex, fragment, etc) into a single executable that runs on the GPU.
     unsigned int m_programID;
 
-    // Holds variables from shader file, ex. Sampler2D.
-    mutable std::unordered_map<std::string, int> m_uniformLocationCache;
+    struct UniformInfo
+    {
+        std::uint32_t hash;
+        UniformHandle handle;
+    };
+
+    // Active uniforms enumerated at link time, sorted by name hash.
+    std::vector<UniformInfo> m_uniforms;
+
+    // Hashes of missing uniforms already reported, each is only reported once.
+    mutable std::vector<std::uint32_t> m_missingUniforms;
+
+    void ReflectUniforms();
 
 public:
 
@@ -38,7 +75,7 @@ public:
     Shader& operator=(const Shader&) = delete;
 
     std::string ParseShaderFile(const std::filesystem::path& filepath);
-    unsigned int CompileShader(unsigned int type, const std::string& source);
+    static unsigned int CompileShader(unsigned int type, const std::string& source);
 
     unsigned int GetID() const noexcept;
 
@@ -46,14 +83,26 @@ public:
     void UnBind() const;
 
     // Set the value of a uniform in current shader.
-    void SetUniform1i(const std::string& name, int value) const;
-    void SetUniform1iv(const std::string& name, int count, int* value) const;
-    void SetUniform1f(const std::string& name, float value) const;
-    void SetUniform3fv(const std::string& name, const int count, const float* value) const;
-    void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3) const;
-    void SetUniformMat4f(const std::string& name, const glm::mat4& matrix) const;
-
-    int GetUniformLocation(const std::string& name) const;
+    void SetUniform1i(Uniform name, int value) const;
+    void SetUniform1iv(Uniform name, int count, const int* value) const;
+    void SetUniform2i(Uniform name, int v0, int v1) const;
+    void SetUniform1f(Uniform name, float value) const;
+    void SetUniform2f(Uniform name, float v0, float v1) const;
+    void SetUniform3fv(Uniform name, const int count, const float* value) const;
+    void SetUniform4f(Uniform name, float v0, float v1, float v2, float v3) const;
+    void SetUniformMat4f(Uniform name, const glm::mat4& matrix) const;
+
+    // Same as above using a pre-resolved handle, no lookup is performed.
+    void SetUniform1i(UniformHandle handle, int value) const;
+    void SetUniform1iv(UniformHandle handle, int count, const int* value) const;
+    void SetUniform2i(UniformHandle handle, int v0, int v1) const;
+    void SetUniform1f(UniformHandle handle, float value) const;
+    void SetUniform2f(UniformHandle handle, float v0, float v1) const;
+    void SetUniform3fv(UniformHandle handle, const int count, const float* value) const;
+    void SetUniform4f(UniformHandle handle, float v0, float v1, float v2, float v3) const;
+    void SetUniformMat4f(UniformHandle handle, const glm::mat4& matrix) const;
+
+    UniformHandle GetUniformHandle(Uniform name) const;
 };
 }// namespace Renderer
 #endif
@@ -0,0 +1,244 @@
+#include "renderer/ShaderCache.h"
+
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <print>
+#include <span>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "renderer/Shader.h"
+#include "utility/Hash.h"
+
+namespace Renderer
+{
+namespace
+{
+    const std::filesystem::path k_CacheDirectory {"cache/shaders"};
+
+    constexpr std::uint32_t k_BinaryMagic   {0x42503947}; // "G9PB"
+    constexpr std::uint32_t k_BinaryVersion {1};
+
+    // Written in front of every program binary on disk.
+    struct BinaryHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t key;
+        std::uint32_t format;
+        std::uint32_t length;
+    };
+
+    std::string_view GLString(GLenum name)
+    {
+        auto str = reinterpret_cast<const char*>(glGetString(name));
+        return str ? std::string_view{str} : std::string_view{};
+    }
+}// anonymous namespace
+
+ShaderCache::ShaderCache():
+m_directory(k_CacheDirectory),
+m_driverHash(0),
+m_binarySupported(false),
+m_initialized(false)
+{}
+
+ShaderCache& ShaderCache::Instance()
+{
+    static ShaderCache cache;
+    return cache;
+}
+
+/*
+ * Deferred until first use, a current OpenGL context is required to query the driver.
+ */
+void ShaderCache::Initialize()
+{
+    if (m_initialized)
+    {
+        return;
+    }
+    m_initialized = true;
+
+    // Binaries are only valid for the exact driver that produced them.
+    m_driverHash = Utility::Fnv1a64(GLString(GL_VENDOR));
+    m_driverHash = Utility::Fnv1a64(GLString(GL_RENDERER), m_driverHash);
+    m_driverHash = Utility::Fnv1a64(GLString(GL_VERSION), m_driverHash);
+    m_driverHash = Utility::Fnv1a64(GLString(GL_SHADING_LANGUAGE_VERSION), m_driverHash);
+
+    int formats {0};
+    if (GLEW_ARB_get_program_binary || GLEW_VERSION_4_1)
+    {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+
+    m_binarySupported = formats > 0 && !ec;
+}
+
+std::filesystem::path ShaderCache::BinaryPath(std::uint64_t key) const
+{
+    return m_directory / std::format("{:016x}.bin", key);
+}
+
+/*
+ * Returns a compiled stage object for the given source, compiling it only the first time it is seen.
+ * The returned ID is owned by the cache; programs must detach, not delete it.
+ *
+ * @param:
+ * type: GL_VERTEX_SHADER or GL_FRAGMENT_SHADER.
+ * source: stage source code.
+ */
+unsigned int ShaderCache::GetStage(unsigned int type, const std::string& source)
+{
+    const auto key {Utility::Fnv1a64(source, 14695981039346656037ull ^ type)};
+    if (auto iter = m_stages.find(key); iter != m_stages.end())
+    {
+        return iter->second;
+    }
+
+    auto id {Shader::CompileShader(type, source)};
+    m_stages.emplace(key, id);
+
+    return id;
+}
+
+/*
+ * Key identifying a linked program: both stage sources and the current driver. The vertex source
+ * length is mixed in between the stages, otherwise moving text from one stage to the other would
+ * keep the key and load the binary of a different program.
+ */
+std::uint64_t ShaderCache::ProgramKey(std::string_view vertexSource, std::string_view fragmentSource)
+{
+    Initialize();
+
+    const std::uint64_t vertexLength {vertexSource.size()};
+    auto key {Utility::Fnv1a64(vertexSource, m_driverHash)};
+    key = Utility::Fnv1a64(std::as_bytes(std::span{&vertexLength, 1}), key);
+    return Utility::Fnv1a64(fragmentSource, key);
+}
+
+/*
+ * Must be called before glLinkProgram for the driver to keep a retrievable binary.
+ */
+void ShaderCache::PrepareProgram(unsigned int programID)
+{
+    Initialize();
+    if (m_binarySupported)
+    {
+        glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+/*
+ * Attempts to restore a linked program from disk. Returns false, and removes the stale file, if the
+ * binary is missing, from another driver or rejected; the caller then compiles from source.
+ */
+bool ShaderCache::LoadProgram(unsigned int programID, std::uint64_t key)
+{
+    Initialize();
+    if (!m_binarySupported)
+    {
+        return false;
+    }
+
+    const auto path {BinaryPath(key)};
+    std::ifstream ifs(path, std::ios_base::in | std::ios_base::binary);
+    if (!ifs)
+    {
+        return false;
+    }
+
+    BinaryHeader header {};
+    ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    std::vector<char> binary;
+    if (ifs && header.magic == k_BinaryMagic && header.version == k_BinaryVersion && header.key == key)
+    {
+        binary.resize(header.length);
+        ifs.read(binary.data(), header.length);
+    }
+    ifs.close();
+
+    int linkStatus {GL_FALSE};
+    if (!binary.empty() && static_cast<std::uint32_t>(binary.size()) == header.length)
+    {
+        glProgramBinary(programID, header.format, binary.data(), static_cast<GLsizei>(header.length));
+        glGetProgramiv(programID, GL_LINK_STATUS, &linkStatus);
+    }
+
+    if (linkStatus == GL_FALSE)
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Writes a linked program's binary to disk, through a temporary file so a crash never leaves a
+ * truncated binary behind. Failures are reported but not fatal.
+ */
+void ShaderCache::StoreProgram(unsigned int programID, std::uint64_t key)
+{
+    if (!m_binarySupported)
+    {
+        return;
+    }
+
+    int length {0};
+    glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    BinaryHeader header {k_BinaryMagic, k_BinaryVersion, key, 0, 0};
+    std::vector<char> binary(length);
+
+    GLsizei written {0};
+    GLenum format {0};
+    glGetProgramBinary(programID, length, &written, &format, binary.data());
+
+    header.format = format;
+    header.length = static_cast<std::uint32_t>(written);
+
+    const auto path {BinaryPath(key)};
+    auto tempFile = path;
+    tempFile += ".tmp";
+
+    try
+    {
+        std::ofstream out;
+        out.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        out.open(tempFile, std::ios_base::binary | std::ios_base::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(binary.data(), written);
+        out.close();
+
+        std::filesystem::rename(tempFile, path);
+    }
+    catch (const std::exception& e)
+    {
+        std::println(stderr, "Failed to write program binary '{}': {}", path.string(), e.what());
+    }
+}
+
+/*
+ * Deletes cached stage objects, must be called while the OpenGL context is still current.
+ */
+void ShaderCache::Clear()
+{
+    for (const auto& [key, id]: m_stages)
+    {
+        glDeleteShader(id);
+    }
+    m_stages.clear();
+}
+}// namespace Renderer
@@ -0,0 +1,57 @@
+#ifndef SHADERCACHE_H
+#define SHADERCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Renderer
+{
+/*
+* Process-wide cache of compiled shader stages and linked program binaries.
+*
+* Stage objects are keyed by stage type and source hash so the same vertex/fragment source is
+* compiled once per run, no matter how many programs use it. Linked programs are written to disk
+* with glGetProgramBinary, keyed by both sources and the driver string, and restored with
+* glProgramBinary on the next launch; any mismatch or rejected binary falls back to compiling
+* from source.
+*/
+class ShaderCache
+{
+private:
+
+    // Compiled stage objects, owned by the cache until Clear().
+    std::unordered_map<std::uint64_t, unsigned int> m_stages;
+
+    std::filesystem::path m_directory;
+    std::uint64_t m_driverHash;
+    bool m_binarySupported;
+    bool m_initialized;
+
+    ShaderCache();
+
+    void Initialize();
+    std::filesystem::path BinaryPath(std::uint64_t key) const;
+
+public:
+
+    static ShaderCache& Instance();
+
+    ~ShaderCache() = default;
+
+    ShaderCache(const ShaderCache&)            = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    unsigned int GetStage(unsigned int type, const std::string& source);
+    std::uint64_t ProgramKey(std::string_view vertexSource, std::string_view fragmentSource);
+
+    void PrepareProgram(unsigned int programID);
+    bool LoadProgram(unsigned int programID, std::uint64_t key);
+    void StoreProgram(unsigned int programID, std::uint64_t key);
+
+    void Clear();
+};
+}// namespace Renderer
+#endif
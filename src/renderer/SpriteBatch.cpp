@@ -0,0 +1,154 @@
+#include "renderer/SpriteBatch.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <numeric>
+
+#include "renderer/GeometryRegistry.h"
+#include "renderer/Packing.h"
+
+namespace Renderer
+{
+namespace
+{
+    const std::filesystem::path k_VertexShader   {"resources/shaders/sprite.vert"};
+    const std::filesystem::path k_FragmentShader {"resources/shaders/sprite.frag"};
+}// anonymous namespace
+
+SpriteBatch::SpriteBatch():
+m_shader(k_VertexShader, k_FragmentShader),
+m_VAO(0),
+m_instanceBuffer(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(k_MaxInstancesPerFrame * sizeof(Instance))),
+m_units(std::min(TextureUnitAllocator::QueryUnitLimit(), k_MaxTextureUnits))
+{
+    m_instances.reserve(k_MaxInstances);
+
+    glGenVertexArrays(1, &m_VAO);
+    glBindVertexArray(m_VAO);
+
+    // Centered quad, scaled and rotated per instance.
+    GeometryRegistry::Instance().AttachMesh(Mesh::CenteredQuad, 0);
+
+    // Per-instance attributes, pointed at the frame's stream allocation before every draw.
+    for (GLuint attribute {1}; attribute <= 6; ++attribute)
+    {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Sampler i reads unit i, set once.
+    std::array<int, k_MaxTextureUnits> units;
+    std::iota(units.begin(), units.end(), 0);
+
+    m_shader.Bind();
+    m_shader.SetUniform1iv("u_Textures", k_MaxTextureUnits, units.data());
+    m_shader.UnBind();
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    glDeleteVertexArrays(1, &m_VAO);
+}
+
+void SpriteBatch::BeginFrame()
+{
+    m_instanceBuffer.BeginFrame();
+}
+
+/*
+* Queues {sprite} at depth buffer value {depth}. Returns false when the batch has no unit left for
+* its texture or is full, the batch must be drawn and the sprite added again.
+*/
+bool SpriteBatch::Add(const Sprite& sprite, float depth)
+{
+    if (m_instances.size() == k_MaxInstances)
+    {
+        return false;
+    }
+
+    const GLint unit {m_units.Acquire(sprite.texture)};
+    if (unit < 0)
+    {
+        return false;
+    }
+
+    m_instances.push_back(
+    {
+        .center      = sprite.position,
+        .size        = PackHalf(sprite.size),
+        .uvRect      = PackUnorm16(sprite.uvRect),
+        .rotation    = PackAngle(sprite.rotation),
+        .textureUnit = static_cast<std::int16_t>(unit),
+        .depth       = depth,
+    });
+    return true;
+}
+
+bool SpriteBatch::IsEmpty() const noexcept
+{
+    return m_instances.empty();
+}
+
+const Shader& SpriteBatch::GetShader() const noexcept
+{
+    return m_shader;
+}
+
+GLuint SpriteBatch::GetVertexArray() const noexcept
+{
+    return m_VAO;
+}
+
+/*
+* Textures of the queued sprites, the one at index i must be bound to unit i before Draw().
+*/
+std::span<const GLuint> SpriteBatch::GetTextures() const noexcept
+{
+    return m_units.GetTextures();
+}
+
+/*
+* Uploads and draws the queued sprites with one instanced call, then empties the batch. The shader
+* must be bound and GetTextures() bound to their units. Returns the number of sprites drawn.
+*/
+GLsizei SpriteBatch::Draw()
+{
+    const auto count {static_cast<GLsizei>(m_instances.size())};
+    const auto allocation {m_instanceBuffer.Allocate(static_cast<GLsizeiptr>(m_instances.size() * sizeof(Instance)))};
+    assert(allocation && "Raise SpriteBatch::k_MaxInstancesPerFrame.");
+
+    if (allocation)
+    {
+        std::memcpy(allocation.data, m_instances.data(), m_instances.size() * sizeof(Instance));
+        m_instanceBuffer.Commit(allocation);
+
+        glBindVertexArray(m_VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer.GetID());
+
+        const auto offset = [&allocation](std::size_t member)
+        {
+            return reinterpret_cast<const void*>(allocation.offset + member);
+        };
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Instance), offset(offsetof(Instance, center)));
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(Instance), offset(offsetof(Instance, size)));
+        glVertexAttribPointer(3, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(Instance), offset(offsetof(Instance, uvRect)));
+        glVertexAttribPointer(4, 1, GL_SHORT, GL_TRUE, sizeof(Instance), offset(offsetof(Instance, rotation)));
+        glVertexAttribIPointer(5, 1, GL_SHORT, sizeof(Instance), offset(offsetof(Instance, textureUnit)));
+        glVertexAttribPointer(6, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), offset(offsetof(Instance, depth)));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glDrawElementsInstanced(GL_TRIANGLES, GeometryRegistry::k_IndicesPerQuad, GL_UNSIGNED_INT, nullptr, count);
+    }
+
+    m_instances.clear();
+    m_units.Reset();
+
+    return allocation ? count : 0;
+}
+}// namespace Renderer
@@ -0,0 +1,84 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include "renderer/Shader.h"
+#include "renderer/StreamBuffer.h"
+#include "renderer/TextureUnits.h"
+
+namespace Renderer
+{
+// A textured quad drawn through RenderQueue::SubmitSprite(), batched with other sprites.
+struct Sprite
+{
+    glm::vec2 position {0.0f};  // world-space center.
+    glm::vec2 size     {0.0f};
+    float rotation     {0.0f};  // radians, counter-clockwise.
+    GLuint texture     {0};
+    glm::vec4 uvRect   {0.0f, 0.0f, 1.0f, 1.0f}; // {min u, min v, max u, max v}.
+};
+
+/*
+* Instanced quads with up to k_MaxTextureUnits different textures per draw: every sprite carries
+* the unit its texture was given by a TextureUnitAllocator, and 'sprite.frag' picks the sampler
+* from 'u_Textures'. A batch is only drawn early when it runs out of units or instances.
+*/
+class SpriteBatch
+{
+private:
+
+    // 28 bytes, see Packing.h for the encodings. Depth stays a float, it is a rank among every
+    // command of the frame and needs more than 16 bits.
+    struct Instance
+    {
+        glm::vec2 center;          // world units.
+        glm::u16vec2 size;         // half floats.
+        glm::u16vec4 uvRect;       // unorm16.
+        std::int16_t rotation;     // PackAngle().
+        std::int16_t textureUnit;
+        float depth;               // NDC z, from RenderQueue.
+    };
+    static_assert(sizeof(Instance) == 28, "Keep sprite instances packed.");
+
+    Shader m_shader;
+
+    GLuint m_VAO;
+
+    StreamBuffer m_instanceBuffer;
+    TextureUnitAllocator m_units;
+    std::vector<Instance> m_instances;
+
+public:
+
+    // Size of 'u_Textures' in sprite.frag; GL 3.3 guarantees 16 fragment texture units.
+    static constexpr GLint k_MaxTextureUnits {16};
+    static constexpr std::size_t k_MaxInstances {4096};
+    static constexpr std::size_t k_MaxInstancesPerFrame {16384};
+
+    SpriteBatch();
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch&)            = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    void BeginFrame();
+
+    bool Add(const Sprite& sprite, float depth);
+    bool IsEmpty() const noexcept;
+
+    const Shader& GetShader() const noexcept;
+    GLuint GetVertexArray() const noexcept;
+    std::span<const GLuint> GetTextures() const noexcept;
+
+    GLsizei Draw();
+};
+}// namespace Renderer
+#endif
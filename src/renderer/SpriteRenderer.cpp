@@ -4,58 +4,20 @@
 #include <glm/ext/matrix_transform.hpp>
 #include <GL/gl.h>
 
+#include "renderer/GeometryRegistry.h"
+
 namespace Renderer
 {
 /*
-* Initializes our quad between (0,0) and (1,1). Creates VBO and VAO, uploads data to GPU.
-* Uses one vertex attribute of 4 floats, to represent position on the x-y axis and
-* texture coordinates uv.
+* Draws the shared unit quad between (0,0) and (1,1); the shader reads the corners as both position
+* and texture coordinates, (0,0) at the bottom-left, (1,1) at top-right.
 */
 SpriteRenderer::SpriteRenderer(std::shared_ptr<Renderer::Shader> shader):
-m_shader(shader)
-{
-    const Vertex vertices[] =
-    {
-        // Texture coordinates are (0,0) at the bottom-left, (1,1) at top-right.
-        // pos      // tex-cordinate
-        {{0.0f, 1.0f}, {0.0f, 1.0f}}, // top-left.
-        {{0.0f, 0.0f}, {0.0f, 0.0f}}, // bottom-left.
-        {{1.0f, 0.0f}, {1.0f, 0.0f}}, // bottom-right.
-
-        {{0.0f, 1.0f}, {0.0f, 1.0f}}, // top left.
-        {{1.0f, 0.0f}, {1.0f, 0.0f}}, // bottom-right.
-        {{1.0f, 1.0f}, {1.0f, 1.0f}}  // top-right.
-    };
-
-    // Bind.
-    glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
-
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    // describe data.
-    glBindVertexArray(m_vao);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(0));
-
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(2 * sizeof(float)));
-
-    // UnBind.
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
-
-/*
- * Deletes Vertex Array Object.
- */
-SpriteRenderer::~SpriteRenderer()
-{
-    glDeleteBuffers(1, &m_vbo);
-    glDeleteVertexArrays(1, &m_vao);
-}
+m_shader(shader),
+m_modelUniform(shader->GetUniformHandle("u_model")),
+m_imageUniform(shader->GetUniformHandle("u_image")),
+m_vao(GeometryRegistry::Instance().GetVertexArray(Mesh::UnitQuad))
+{}
 
 /*
  * Draws the given texture using the intialized Shader. Allows for model position, size, and rotation movement.
@@ -84,8 +46,8 @@ void SpriteRenderer::DrawSprite(std::shared_ptr<Renderer::Texture2D> texture, gl
     // scale.
     model = glm::scale(model, glm::vec3(size, 1.0f));
 
-    m_shader->SetUniformMat4f("u_model", model);
-    m_shader->SetUniform1i("u_image", texture->GetTextureSlot());
+    m_shader->SetUniformMat4f(m_modelUniform, model);
+    m_shader->SetUniform1i(m_imageUniform, texture->GetTextureSlot());
 
     texture->Bind();
     this->Draw();
@@ -95,29 +57,20 @@ void SpriteRenderer::DrawSprite(std::shared_ptr<Renderer::Texture2D> texture, Ut
 {
     m_shader->Bind();
 
-    m_shader->SetUniformMat4f("u_model",transform.ComputeLocalModelMatrix());
-    m_shader->SetUniform1i("u_image", texture->GetTextureSlot());
+    m_shader->SetUniformMat4f(m_modelUniform, transform.ComputeLocalModelMatrix());
+    m_shader->SetUniform1i(m_imageUniform, texture->GetTextureSlot());
 
     texture->Bind();
     this->Draw();
 }
 
-/*
- * Updates projection matrix value but does not make a draw call.
- */
-void SpriteRenderer::UpdateProjection(const glm::mat4& projection)
-{
-    m_shader->Bind();
-    m_shader->SetUniformMat4f("u_projection", projection);
-}
-
 /*
 * Binds vertex array and makes a draw call.
 */
 void SpriteRenderer::Draw()
 {
     glBindVertexArray(m_vao);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glDrawElements(GL_TRIANGLES, GeometryRegistry::k_IndicesPerQuad, GL_UNSIGNED_INT, nullptr);
     glBindVertexArray(0);
 }
 }// namespace Renderer
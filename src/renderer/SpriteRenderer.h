@@ -15,31 +15,25 @@
 
 namespace Renderer
 {
-struct Vertex
-{
-    glm::vec2 position;
-    glm::vec2 uvs;
-};
 /*
 * Manages a Sprite using a given shader and allows modification to its' model matrix.
-* Creates a default Quad when constructed and draws a 2D texture.
+* Draws a 2D texture on the GeometryRegistry unit quad.
 */
 class SpriteRenderer
 {
 private:
     std::shared_ptr<Renderer::Shader> m_shader;
-    unsigned int m_vao;
-    unsigned int m_vbo;
+    Renderer::UniformHandle m_modelUniform;
+    Renderer::UniformHandle m_imageUniform;
+    unsigned int m_vao; // GeometryRegistry's unit quad, positions double as texture coordinates.
 
 public:
     SpriteRenderer(std::shared_ptr<Renderer::Shader> shader);
-    ~SpriteRenderer();
+    ~SpriteRenderer() = default;
 
     void DrawSprite(std::shared_ptr<Renderer::Texture2D> texture, glm::vec2 position = glm::vec2(0.0f), glm::vec2 size = glm::vec2(10.0f, 10.0f), float rotate = 0.0f);
     void DrawSprite(std::shared_ptr<Renderer::Texture2D> texture, Utility::Transform transform);
 
-    void UpdateProjection(const glm::mat4& projection);
-
 private:
     void Draw();
 };
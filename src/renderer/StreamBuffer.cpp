@@ -0,0 +1,216 @@
+#include "renderer/StreamBuffer.h"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace Renderer
+{
+namespace
+{
+    constexpr GLuint64 k_FenceTimeout {1'000'000'000}; // 1 second in nanoseconds.
+
+    constexpr GLbitfield k_PersistentFlags {GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT};
+}// anonymous namespace
+
+/*
+* @params:
+* target: buffer binding target, ex. GL_ARRAY_BUFFER or GL_UNIFORM_BUFFER.
+* regionSize: bytes available to a single frame.
+* framesInFlight: frames the CPU may run ahead of the GPU before waiting.
+*/
+StreamBuffer::StreamBuffer(GLenum target, GLsizeiptr regionSize, unsigned int framesInFlight):
+m_buffer(0),
+m_target(target),
+m_regionSize(regionSize),
+m_regionCount(framesInFlight),
+m_region(0),
+m_head(0),
+m_fences(framesInFlight, nullptr),
+m_mapped(nullptr),
+m_persistent(GLEW_ARB_buffer_storage || GLEW_VERSION_4_4),
+m_frameStarted(false)
+{
+    assert(m_regionCount > 0 && m_regionSize > 0);
+
+    const GLsizeiptr totalSize {m_regionSize * m_regionCount};
+
+    glGenBuffers(1, &m_buffer);
+    if (!m_buffer)
+    {
+        throw std::runtime_error("StreamBuffer: failed to create buffer.");
+    }
+
+    glBindBuffer(m_target, m_buffer);
+
+    if (m_persistent)
+    {
+        glBufferStorage(m_target, totalSize, nullptr, k_PersistentFlags);
+        m_mapped = static_cast<std::byte*>(glMapBufferRange(m_target, 0, totalSize, k_PersistentFlags));
+        m_persistent = m_mapped != nullptr;
+
+        if (!m_persistent)
+        {
+            // Immutable storage cannot be respecified with glBufferData, start over with a new buffer.
+            glBindBuffer(m_target, 0);
+            glDeleteBuffers(1, &m_buffer);
+            glGenBuffers(1, &m_buffer);
+            if (!m_buffer)
+            {
+                throw std::runtime_error("StreamBuffer: failed to create buffer.");
+            }
+            glBindBuffer(m_target, m_buffer);
+        }
+    }
+
+    if (!m_persistent)
+    {
+        glBufferData(m_target, totalSize, nullptr, GL_STREAM_DRAW);
+    }
+
+    glBindBuffer(m_target, 0);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for (auto& fence: m_fences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+    }
+
+    if (m_mapped)
+    {
+        glBindBuffer(m_target, m_buffer);
+        glUnmapBuffer(m_target);
+        glBindBuffer(m_target, 0);
+    }
+
+    if (m_buffer != 0)
+    {
+        glDeleteBuffers(1, &m_buffer);
+    }
+}
+
+/*
+* Blocks until the GPU has finished with every command issued before the region's fence.
+*/
+void StreamBuffer::WaitForRegion(unsigned int region)
+{
+    auto& fence {m_fences[region]};
+    if (!fence)
+    {
+        return;
+    }
+
+    GLenum result {glClientWaitSync(fence, 0, 0)};
+    while (result == GL_TIMEOUT_EXPIRED)
+    {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, k_FenceTimeout);
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+/*
+* Starts a new frame: fences the region used by the previous frame (its draws have all been issued
+* by now) and moves on to the next region, waiting only if the GPU still reads from it.
+*/
+void StreamBuffer::BeginFrame()
+{
+    if (m_frameStarted)
+    {
+        if (m_persistent)
+        {
+            m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+        m_region = (m_region + 1) % m_regionCount;
+    }
+    m_frameStarted = true;
+    m_head = 0;
+
+    if (m_persistent)
+    {
+        WaitForRegion(m_region);
+    }
+    else if (m_region == 0)
+    {
+        // Orphan: the driver hands back fresh storage while in-flight frames keep the old one.
+        glBindBuffer(m_target, m_buffer);
+        glBufferData(m_target, m_regionSize * m_regionCount, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(m_target, 0);
+    }
+}
+
+/*
+* Suballocates from the current frame's region. Returns an empty allocation when the region is
+* full; the region size should be raised rather than relying on that. On the orphaning path only
+* one range can be mapped at a time, Commit() it before the next Allocate() or draw.
+*
+* @params:
+* size: bytes requested.
+* alignment: power of two, ex. GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT for uniform ranges.
+*/
+StreamAllocation StreamBuffer::Allocate(GLsizeiptr size, GLsizeiptr alignment)
+{
+    assert(m_frameStarted && "BeginFrame() must be called before Allocate().");
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    const GLsizeiptr start {(m_head + alignment - 1) & ~(alignment - 1)};
+    if (size <= 0 || start + size > m_regionSize)
+    {
+        return StreamAllocation{};
+    }
+    m_head = start + size;
+
+    const GLintptr offset {m_region * m_regionSize + start};
+    if (m_persistent)
+    {
+        return StreamAllocation{m_mapped + offset, offset, size};
+    }
+
+    glBindBuffer(m_target, m_buffer);
+    void* data {glMapBufferRange(m_target, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT)};
+    glBindBuffer(m_target, 0);
+
+    return StreamAllocation{data, offset, data ? size : 0};
+}
+
+/*
+* Makes written data visible to the GPU. The persistent mapping is coherent so this only
+* unmaps on the orphaning path.
+*/
+void StreamBuffer::Commit(const StreamAllocation& allocation)
+{
+    if (m_persistent || !allocation)
+    {
+        return;
+    }
+
+    glBindBuffer(m_target, m_buffer);
+    glUnmapBuffer(m_target);
+    glBindBuffer(m_target, 0);
+}
+
+GLuint StreamBuffer::GetID() const noexcept
+{
+    return m_buffer;
+}
+
+GLenum StreamBuffer::GetTarget() const noexcept
+{
+    return m_target;
+}
+
+GLsizeiptr StreamBuffer::GetRegionSize() const noexcept
+{
+    return m_regionSize;
+}
+
+bool StreamBuffer::IsPersistent() const noexcept
+{
+    return m_persistent;
+}
+}// namespace Renderer
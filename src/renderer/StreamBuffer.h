@@ -0,0 +1,72 @@
+#ifndef STREAMBUFFER_H
+#define STREAMBUFFER_H
+
+#include <cstddef>
+#include <vector>
+
+#include <GL/glew.h>
+
+namespace Renderer
+{
+// A suballocation handed out by StreamBuffer, valid until the next BeginFrame().
+struct StreamAllocation
+{
+    void* data         {nullptr}; // write-only CPU pointer.
+    GLintptr offset    {0};       // byte offset into the buffer, for attribute pointers or glBindBufferRange.
+    GLsizeiptr size    {0};
+
+    explicit operator bool() const noexcept {return data != nullptr;}
+};
+
+/*
+* Ring buffer for data rewritten every frame (vertices, instances, uniforms). The buffer is split
+* into one region per frame in flight; each frame suballocates linearly from its own region so the
+* CPU never writes memory the GPU may still be reading.
+*
+* With ARB_buffer_storage the buffer is persistently mapped and regions are guarded by fences
+* (glFenceSync), the CPU only waits when it is more than framesInFlight frames ahead. On plain
+* GL 3.3 the buffer is orphaned every time the ring wraps and ranges are mapped unsynchronized.
+*/
+class StreamBuffer
+{
+private:
+
+    GLuint m_buffer;
+    GLenum m_target;
+
+    GLsizeiptr m_regionSize;
+    unsigned int m_regionCount;
+
+    unsigned int m_region; // region written this frame.
+    GLsizeiptr m_head;     // next free byte within the region.
+
+    std::vector<GLsync> m_fences;
+    std::byte* m_mapped;   // persistent mapping, null on the orphaning path.
+
+    bool m_persistent;
+    bool m_frameStarted;
+
+    void WaitForRegion(unsigned int region);
+
+public:
+
+    StreamBuffer(GLenum target, GLsizeiptr regionSize, unsigned int framesInFlight = 3);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&)            = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+    StreamBuffer(StreamBuffer&&)                 = delete;
+    StreamBuffer& operator=(StreamBuffer&&)      = delete;
+
+    void BeginFrame();
+
+    StreamAllocation Allocate(GLsizeiptr size, GLsizeiptr alignment = 16);
+    void Commit(const StreamAllocation& allocation);
+
+    GLuint GetID() const noexcept;
+    GLenum GetTarget() const noexcept;
+    GLsizeiptr GetRegionSize() const noexcept;
+    bool IsPersistent() const noexcept;
+};
+}// namespace Renderer
+#endif
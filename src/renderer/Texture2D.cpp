@@ -2,15 +2,24 @@
 
 #include <memory>
 #include <cassert>
+#include <cstring>
 #include <stdexcept>
+#include <system_error>
 
 #include <GL/glew.h>
 #include <stb_image.h>
 
 namespace Renderer
 {
+namespace
+{
+    // Set once at startup, before any texture loads; empty looks next to the images.
+    std::filesystem::path g_cookedDirectory;
+}// anonymous namespace
+
 /*
-* Generates a 2D texture from the given path and sets active texture slot.
+* Generates a 2D texture from the given path and sets active texture slot. A cooked '.g9tex' of
+* the image is used instead when it is at least as new as the image, see PreferCooked().
 *
 * @params:
 * texturePath: path to 2D texture.
@@ -19,17 +28,246 @@ namespace Renderer
 Texture2D::Texture2D(const std::filesystem::path& texturePath, int textureSlot, TextureParams params):
 m_ID(0),
 m_textureSlot(textureSlot),
+m_byteSize(0),
+m_texParams(params)
+{
+    assert(m_textureSlot < GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
+
+    const auto source {PreferCooked(texturePath)};
+    if (IsCooked(source))
+    {
+        const auto image {ReadCooked(source)};
+        CreateCooked(image, image.data.data());
+    }
+    else
+    {
+        const auto image {Decode(source)};
+        Create(image.width, image.height, image.channels, image.pixels.get());
+    }
+}
+
+/*
+* Generates a 2D texture from already decoded pixels. When a buffer is bound to
+* GL_PIXEL_UNPACK_BUFFER, {pixels} is an offset into that buffer instead of a CPU pointer.
+*
+* @params:
+* channels: 1 to 4, as returned by stbi_load.
+* pixels: rows bottom to top, tightly packed.
+*/
+Texture2D::Texture2D(int width, int height, int channels, const void* pixels, int textureSlot, TextureParams params):
+m_ID(0),
+m_textureSlot(textureSlot),
+m_byteSize(0),
+m_texParams(params)
+{
+    assert(m_textureSlot < GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
+
+    Create(width, height, channels, pixels);
+}
+
+/*
+* Generates a 2D texture from a cooked image, every level is uploaded as stored and no mipmaps
+* are generated. {texels} is the start of the file's data, or an offset into the bound
+* GL_PIXEL_UNPACK_BUFFER the file was copied to.
+*/
+Texture2D::Texture2D(const CookedImage& image, const std::byte* texels, int textureSlot, TextureParams params):
+m_ID(0),
+m_textureSlot(textureSlot),
+m_byteSize(0),
 m_texParams(params)
 {
     assert(m_textureSlot < GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
 
-    stbi_set_flip_vertically_on_load(true);
+    CreateCooked(image, texels);
+}
+
+/*
+* Decodes an image from the resource pack or file, thread-safe so loaders may call it from worker threads.
+*/
+Image Texture2D::Decode(const std::filesystem::path& texturePath)
+{
+    const auto resource {Utility::ReadResource(texturePath)};
+    if (!resource)
+    {
+        throw std::runtime_error(resource.error());
+    }
+
+    stbi_set_flip_vertically_on_load_thread(true);
 
     // stbi_load will return the number of channels in the image if desired_channels (last value) is 0.
-    int channels{0}, imageWidth{0}, imageHeight{0};
-    std::unique_ptr<unsigned char[], decltype(stbi_image_free)*>
-    buffer(stbi_load(texturePath.c_str(), &imageWidth, &imageHeight, &channels, 0), stbi_image_free);
+    const auto bytes {resource->GetBytes()};
+    Image image;
+    image.pixels = {stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(bytes.data()), static_cast<int>(bytes.size()),
+            &image.width, &image.height, &image.channels, 0), stbi_image_free};
+
+    if (!image.pixels)
+    {
+        throw std::runtime_error(std::string{"Failed to load Texture: "} + std::string{stbi_failure_reason()});
+    }
+
+    return image;
+}
+
+/*
+* Reads and validates a '.g9tex' file, thread-safe. Texels are not copied out of the resource
+* pack. Throws if the file is truncated or was written by another version of the cooker.
+*/
+CookedImage Texture2D::ReadCooked(const std::filesystem::path& cookedPath)
+{
+    auto resource {Utility::ReadResource(cookedPath)};
+    if (!resource)
+    {
+        throw std::runtime_error("Failed to open cooked texture: " + resource.error());
+    }
+
+    CookedImage image;
+    image.file = std::move(*resource);
+    image.data = image.file.GetBytes();
+
+    if (image.data.size() < sizeof(CookedTextureHeader))
+    {
+        throw std::runtime_error("Truncated cooked texture: " + cookedPath.string());
+    }
+
+    std::memcpy(&image.header, image.data.data(), sizeof(CookedTextureHeader));
+    const auto& header {image.header};
+
+    if (header.magic != k_CookedTextureMagic || header.version != k_CookedTextureVersion)
+    {
+        throw std::runtime_error("Cooked texture has an unknown version, cook it again: " + cookedPath.string());
+    }
+
+    if (header.mipCount == 0 || header.mipCount > k_MaxCookedMipLevels ||
+        image.data.size() < sizeof(CookedTextureHeader) + header.mipCount * sizeof(CookedMipLevel))
+    {
+        throw std::runtime_error("Corrupt cooked texture: " + cookedPath.string());
+    }
+
+    image.levels.resize(header.mipCount);
+    std::memcpy(image.levels.data(), image.data.data() + sizeof(CookedTextureHeader), header.mipCount * sizeof(CookedMipLevel));
+
+    for (const auto& level: image.levels)
+    {
+        if (level.offset + level.size > image.data.size() || level.size != MipByteSize(header.format, level.width, level.height))
+        {
+            throw std::runtime_error("Corrupt cooked texture: " + cookedPath.string());
+        }
+    }
 
+    return image;
+}
+
+bool Texture2D::IsCooked(const std::filesystem::path& texturePath)
+{
+    return texturePath.extension() == ".g9tex";
+}
+
+/*
+* Returns the cooked version of {texturePath} when the resource pack holds it, or it exists in the
+* cooked directory and is not older than the source, otherwise {texturePath} itself.
+*/
+std::filesystem::path Texture2D::PreferCooked(const std::filesystem::path& texturePath)
+{
+    if (IsCooked(texturePath))
+    {
+        return texturePath;
+    }
+
+    if (const auto* pack {Utility::GetMountedPack()})
+    {
+        if (const auto packed {CookedTexturePath(texturePath)}; pack->Contains(packed))
+        {
+            return packed;
+        }
+    }
+
+    const auto cooked {CookedTexturePath(texturePath, g_cookedDirectory)};
+
+    std::error_code error;
+    const auto cookedTime {std::filesystem::last_write_time(cooked, error)};
+    if (error)
+    {
+        return texturePath;
+    }
+
+    const auto sourceTime {std::filesystem::last_write_time(texturePath, error)};
+    return (error || cookedTime >= sourceTime) ? cooked : texturePath;
+}
+
+/*
+* Where PreferCooked() looks for cooked files on disk, the gamenine-cook '--output-dir'. Not thread
+* safe, call before textures are loaded.
+*/
+void Texture2D::SetCookedDirectory(const std::filesystem::path& directory)
+{
+    g_cookedDirectory = directory;
+}
+
+void Texture2D::SetParameters() const
+{
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_texParams.wrapS);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_texParams.wrapT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_texParams.minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_texParams.magFilter);
+}
+
+void Texture2D::CreateCooked(const CookedImage& image, const std::byte* texels)
+{
+    const auto format {image.header.format};
+    if (IsCompressed(format) && !GLEW_EXT_texture_compression_s3tc)
+    {
+        throw std::runtime_error("Cooked texture is S3TC compressed, which this driver does not support.");
+    }
+
+    glGenTextures(1, &m_ID);
+    glActiveTexture(GL_TEXTURE0 + m_textureSlot);
+    glBindTexture(GL_TEXTURE_2D, m_ID);
+
+    SetParameters();
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size()) - 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    for (GLint mip {0}; mip < static_cast<GLint>(image.levels.size()); ++mip)
+    {
+        const auto& level {image.levels[mip]};
+        const auto* data {texels + level.offset};
+        const auto width {static_cast<GLsizei>(level.width)};
+        const auto height {static_cast<GLsizei>(level.height)};
+
+        switch (format)
+        {
+            case TexelFormat::R8:
+                glTexImage2D(GL_TEXTURE_2D, mip, GL_RED, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, data);
+                break;
+            case TexelFormat::RG8:
+                glTexImage2D(GL_TEXTURE_2D, mip, GL_RG, width, height, 0, GL_RG, GL_UNSIGNED_BYTE, data);
+                break;
+            case TexelFormat::RGB8:
+                glTexImage2D(GL_TEXTURE_2D, mip, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                break;
+            case TexelFormat::RGBA8:
+                glTexImage2D(GL_TEXTURE_2D, mip, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                break;
+            case TexelFormat::BC1:
+                glCompressedTexImage2D(GL_TEXTURE_2D, mip, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, width, height, 0, static_cast<GLsizei>(level.size), data);
+                break;
+            case TexelFormat::BC3:
+                glCompressedTexImage2D(GL_TEXTURE_2D, mip, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, width, height, 0, static_cast<GLsizei>(level.size), data);
+                break;
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    for (const auto& level: image.levels)
+    {
+        m_byteSize += static_cast<std::size_t>(level.size);
+    }
+}
+
+void Texture2D::Create(int width, int height, int channels, const void* pixels)
+{
     GLint internalFormat{0}; // gpu storage.
     GLenum dataFormat{0};   // incoming data.
 
@@ -51,41 +289,43 @@ m_texParams(params)
         break;
     }
 
-    if (buffer)
-    {
-        glGenTextures(1, &m_ID);
-        glActiveTexture(GL_TEXTURE0 + m_textureSlot);
-        glBindTexture(GL_TEXTURE_2D, m_ID);
+    glGenTextures(1, &m_ID);
+    glActiveTexture(GL_TEXTURE0 + m_textureSlot);
+    glBindTexture(GL_TEXTURE_2D, m_ID);
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_texParams.wrapS);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_texParams.wrapT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_texParams.minFilter);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_texParams.magFilter);
+    SetParameters();
 
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, imageWidth, imageHeight, 0, dataFormat, GL_UNSIGNED_BYTE, buffer.get());
-        glGenerateMipmap(GL_TEXTURE_2D);
+    // Rows are tightly packed, RGB rows are not always a multiple of 4 bytes.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+    // A full mip chain adds a third on top of the base level.
+    m_byteSize = static_cast<std::size_t>(width) * height * channels;
+    if (m_texParams.generateMipmaps)
+    {
+        glGenerateMipmap(GL_TEXTURE_2D);
+        m_byteSize += m_byteSize / 3;
     }
     else
     {
-        throw std::runtime_error(std::string{"Failed to load Texture: "} + std::string{stbi_failure_reason()});
+        // Only the base level exists, keeps the texture complete with a mipmap min filter.
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
     }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 Texture2D::Texture2D(Texture2D&& other) noexcept
 {
-    if (this->m_ID != 0)
-    {
-        glDeleteTextures(1, &this->m_ID);
-    }
-
     this->m_ID          = other.m_ID;
     this->m_textureSlot = other.m_textureSlot;
+    this->m_byteSize    = other.m_byteSize;
     this->m_texParams   = std::move(other.m_texParams);
 
     other.m_ID = 0;
     other.m_textureSlot = 0;
+    other.m_byteSize = 0;
 }
 
 Texture2D& Texture2D::operator=(Texture2D&& other) noexcept
@@ -102,10 +342,12 @@ Texture2D& Texture2D::operator=(Texture2D&& other) noexcept
 
     this->m_ID          = other.m_ID;
     this->m_textureSlot = other.m_textureSlot;
+    this->m_byteSize    = other.m_byteSize;
     this->m_texParams   = std::move(other.m_texParams);
 
     other.m_ID = 0;
     other.m_textureSlot = 0;
+    other.m_byteSize = 0;
 
     return *this;
 }
@@ -132,6 +374,12 @@ int Texture2D::GetTextureSlot() const noexcept
     return m_textureSlot;
 }
 
+/* Returns the texture's estimated GPU memory in bytes. */
+std::size_t Texture2D::GetByteSize() const noexcept
+{
+    return m_byteSize;
+}
+
 /* Sets active texture and binds. */
 void Texture2D::Bind() const
 {
@@ -1,10 +1,17 @@
 #ifndef TEXTURE2D_H
 #define TEXTURE2D_H
 
+#include <cstddef>
 #include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
 
 #include <GL/glew.h>
 
+#include "renderer/TextureFormat.h"
+#include "utility/ResourcePack.h"
+
 namespace Renderer
 {
 struct TextureParams
@@ -16,9 +23,30 @@ struct TextureParams
 
     bool generateMipmaps{true};
 };
+
+// Decoded pixels, rows bottom to top. Safe to produce off the main thread.
+struct Image
+{
+    int width    {0};
+    int height   {0};
+    int channels {0};
+    std::unique_ptr<unsigned char[], void(*)(void*)> pixels {nullptr, nullptr};
+
+    std::size_t GetByteSize() const noexcept {return static_cast<std::size_t>(width) * height * channels;}
+};
+
+// A '.g9tex' file, level offsets index into {data}.
+struct CookedImage
+{
+    CookedTextureHeader header {};
+    std::vector<CookedMipLevel> levels;
+    Utility::ResourceData file;       // owns {data}; a view into the resource pack when mounted.
+    std::span<const std::byte> data;  // the whole file.
+};
+
 /*
 * Generates a 2D Texture using third-party vendor STBI to load
-* image data.
+* image data, or from a '.g9tex' file cooked by gamenine-cook which is uploaded as is.
 */
 class Texture2D
 {
@@ -26,12 +54,19 @@ private:
 
     GLuint m_ID;
     GLint  m_textureSlot;
+    std::size_t m_byteSize; // GPU memory, every mip level included.
 
     TextureParams m_texParams;
 
+    void Create(int width, int height, int channels, const void* pixels);
+    void CreateCooked(const CookedImage& image, const std::byte* texels);
+    void SetParameters() const;
+
 public:
 
     Texture2D(const std::filesystem::path& texturePath, int textureSlot = 0, TextureParams params = {});
+    Texture2D(int width, int height, int channels, const void* pixels, int textureSlot = 0, TextureParams params = {});
+    Texture2D(const CookedImage& image, const std::byte* texels, int textureSlot = 0, TextureParams params = {});
     Texture2D(Texture2D&& other) noexcept;
     Texture2D& operator=(Texture2D&&) noexcept;
 
@@ -42,9 +77,18 @@ public:
 
     GLuint GetID() const noexcept;
     GLint GetTextureSlot() const noexcept;
+    std::size_t GetByteSize() const noexcept;
 
     void Bind() const;
     void UnBind() const;
+
+    static Image Decode(const std::filesystem::path& texturePath);
+    static CookedImage ReadCooked(const std::filesystem::path& cookedPath);
+
+    static bool IsCooked(const std::filesystem::path& texturePath);
+    static std::filesystem::path PreferCooked(const std::filesystem::path& texturePath);
+
+    static void SetCookedDirectory(const std::filesystem::path& directory);
 };
 }// namespace Renderer
 #endif
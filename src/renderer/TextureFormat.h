@@ -0,0 +1,83 @@
+#ifndef TEXTUREFORMAT_H
+#define TEXTUREFORMAT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <type_traits>
+
+namespace Renderer
+{
+/*
+* '.g9tex' cooked texture container, written by gamenine-cook and read by Texture2D. Texel data is
+* stored ready for upload: rows bottom to top (already flipped for GL), every mip level present,
+* optionally block compressed. No GL types here so the cooker builds without a GL context.
+*
+* Layout: CookedTextureHeader | CookedMipLevel[mipCount] | texel data.
+*/
+constexpr std::uint32_t k_CookedTextureMagic   {0x58543947}; // 'G9TX' little-endian.
+constexpr std::uint32_t k_CookedTextureVersion {1};
+constexpr std::uint32_t k_MaxCookedMipLevels   {16};
+
+enum class TexelFormat: std::uint32_t
+{
+    R8    = 1,
+    RG8   = 2,
+    RGB8  = 3,
+    RGBA8 = 4,
+    BC1   = 5, // DXT1, RGB with 1-bit alpha, 8 bytes per 4x4 block.
+    BC3   = 6, // DXT5, RGBA, 16 bytes per 4x4 block.
+};
+
+struct CookedTextureHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    TexelFormat   format;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t mipCount;
+};
+static_assert(std::is_trivially_copyable_v<CookedTextureHeader> && sizeof(CookedTextureHeader) == 24);
+
+struct CookedMipLevel
+{
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint64_t offset; // from the start of the file.
+    std::uint64_t size;
+};
+static_assert(std::is_trivially_copyable_v<CookedMipLevel> && sizeof(CookedMipLevel) == 24);
+
+constexpr bool IsCompressed(TexelFormat format) noexcept
+{
+    return format == TexelFormat::BC1 || format == TexelFormat::BC3;
+}
+
+/*
+* Bytes of one mip level, compressed levels round up to whole 4x4 blocks.
+*/
+constexpr std::size_t MipByteSize(TexelFormat format, std::uint32_t width, std::uint32_t height) noexcept
+{
+    if (IsCompressed(format))
+    {
+        const std::size_t blocks {static_cast<std::size_t>(std::max(1u, (width + 3) / 4)) * std::max(1u, (height + 3) / 4)};
+        return blocks * (format == TexelFormat::BC1 ? 8 : 16);
+    }
+
+    return static_cast<std::size_t>(width) * height * static_cast<std::uint32_t>(format);
+}
+
+/*
+* Where gamenine-cook writes the cooked version of {source}: next to it, or under {cookedRoot} at
+* the source's relative path. Resource pack entries always use the path next to the source.
+*/
+inline std::filesystem::path CookedTexturePath(const std::filesystem::path& source, const std::filesystem::path& cookedRoot = {})
+{
+    auto cooked {cookedRoot.empty() ? source : cookedRoot / source.relative_path()};
+    cooked.replace_extension(".g9tex");
+    return cooked;
+}
+}// namespace Renderer
+#endif
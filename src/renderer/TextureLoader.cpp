@@ -0,0 +1,285 @@
+#include "renderer/TextureLoader.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <print>
+
+namespace Renderer
+{
+namespace
+{
+    // Bytes uploaded per frame, also the size of each region of the upload ring.
+    constexpr GLsizeiptr k_UploadBudget {4 * 1024 * 1024};
+
+    constexpr unsigned int k_MaxWorkers {2};
+
+    // 1x1 opaque grey shown while the real texture loads.
+    constexpr std::array<unsigned char, 4> k_PlaceholderPixel {128, 128, 128, 255};
+}// anonymous namespace
+
+AsyncTexture::AsyncTexture(std::filesystem::path path, int textureSlot, TextureParams params, GLuint placeholder):
+m_path(std::move(path)),
+m_textureSlot(textureSlot),
+m_params(params),
+m_placeholder(placeholder),
+m_status(Status::Pending)
+{}
+
+/*
+* Real texture once uploaded, the placeholder while pending or after a failed load.
+*/
+GLuint AsyncTexture::GetID() const noexcept
+{
+    return m_texture ? m_texture->GetID() : m_placeholder;
+}
+
+GLint AsyncTexture::GetTextureSlot() const noexcept
+{
+    return m_textureSlot;
+}
+
+AsyncTexture::Status AsyncTexture::GetStatus() const noexcept
+{
+    return m_status.load(std::memory_order_acquire);
+}
+
+bool AsyncTexture::IsReady() const noexcept
+{
+    return GetStatus() == Status::Ready;
+}
+
+const std::filesystem::path& AsyncTexture::GetPath() const noexcept
+{
+    return m_path;
+}
+
+/* Null until the texture is ready. */
+const Texture2D* AsyncTexture::GetTexture() const noexcept
+{
+    return m_texture.get();
+}
+
+TextureLoader::TextureLoader():
+m_pending(0)
+{}
+
+TextureLoader& TextureLoader::Instance()
+{
+    static TextureLoader loader;
+    return loader;
+}
+
+/*
+* Deferred until the first load so the GL context exists.
+*/
+void TextureLoader::Initialize()
+{
+    if (!m_workers.empty())
+    {
+        return;
+    }
+
+    TextureParams params;
+    params.minFilter = GL_NEAREST;
+    params.magFilter = GL_NEAREST;
+    m_placeholder  = std::make_unique<Texture2D>(1, 1, 4, k_PlaceholderPixel.data(), 0, params);
+    m_uploadBuffer = std::make_unique<StreamBuffer>(GL_PIXEL_UNPACK_BUFFER, k_UploadBudget);
+
+    const unsigned int workers {std::clamp(std::thread::hardware_concurrency(), 2u, k_MaxWorkers + 1) - 1};
+    for (unsigned int i {0}; i < workers; ++i)
+    {
+        m_workers.emplace_back([this](std::stop_token stop){WorkerLoop(stop);});
+    }
+}
+
+/*
+* Queues a texture for decoding and returns immediately. Loading a path that is already loading or
+* loaded returns the existing handle, whatever slot or params the new request asked for.
+*
+* @params:
+* texturePath: path to 2D texture.
+* textureSlot: texture unit the texture is drawn from.
+*/
+TextureHandle TextureLoader::Load(const std::filesystem::path& texturePath, int textureSlot, TextureParams params)
+{
+    Initialize();
+
+    const auto key {texturePath.lexically_normal().string()};
+    if (auto iter = m_textures.find(key); iter != m_textures.end())
+    {
+        if (auto existing = iter->second.lock())
+        {
+            return existing;
+        }
+    }
+
+    auto texture {std::make_shared<AsyncTexture>(texturePath, textureSlot, params, m_placeholder->GetID())};
+    m_textures[key] = texture;
+    ++m_pending;
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_requests.push_back(texture);
+    }
+    m_wake.notify_one();
+
+    return texture;
+}
+
+void TextureLoader::WorkerLoop(std::stop_token stop)
+{
+    while (true)
+    {
+        TextureHandle texture;
+        {
+            std::unique_lock lock(m_mutex);
+            if (!m_wake.wait(lock, stop, [this]{return !m_requests.empty();}))
+            {
+                return;
+            }
+
+            texture = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+
+        try
+        {
+            Decoded decoded;
+
+            const auto source {Texture2D::PreferCooked(texture->GetPath())};
+            if (Texture2D::IsCooked(source))
+            {
+                decoded.cooked = Texture2D::ReadCooked(source);
+            }
+            else
+            {
+                decoded.image = Texture2D::Decode(source);
+            }
+            decoded.texture = std::move(texture);
+
+            std::lock_guard lock(m_mutex);
+            m_decoded.push_back(std::move(decoded));
+        }
+        catch (const std::exception& e)
+        {
+            std::println(stderr, "Failed to load texture '{}': {}", texture->GetPath().string(), e.what());
+            texture->m_status.store(AsyncTexture::Status::Failed, std::memory_order_release);
+            --m_pending;
+        }
+    }
+}
+
+/*
+* Uploads decoded textures, call once per frame on the main thread. Stops once the frame's upload
+* budget is spent, the rest carries over to the next frame.
+*/
+void TextureLoader::Update()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        std::ranges::move(m_decoded, std::back_inserter(m_ready));
+        m_decoded.clear();
+    }
+
+    if (m_ready.empty())
+    {
+        return;
+    }
+
+    m_uploadBuffer->BeginFrame();
+
+    std::size_t uploaded {0};
+    while (!m_ready.empty() && uploaded < static_cast<std::size_t>(k_UploadBudget))
+    {
+        auto& decoded {m_ready.front()};
+
+        // Nobody holds the handle anymore, skip the upload.
+        if (decoded.texture.use_count() > 1)
+        {
+            uploaded += decoded.GetByteSize();
+            try
+            {
+                Upload(decoded);
+            }
+            catch (const std::exception& e)
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                std::println(stderr, "Failed to create texture '{}': {}", decoded.texture->GetPath().string(), e.what());
+                decoded.texture->m_status.store(AsyncTexture::Status::Failed, std::memory_order_release);
+            }
+        }
+
+        m_ready.pop_front();
+        --m_pending;
+    }
+}
+
+/*
+* Copies the pixels into this frame's region of the upload ring and creates the texture from the
+* bound unpack buffer. Images larger than what is left of the region upload from CPU memory.
+*/
+void TextureLoader::Upload(Decoded& decoded)
+{
+    const auto& image {decoded.image};
+    const auto& cooked {decoded.cooked};
+    auto& texture {*decoded.texture};
+
+    const void* source {decoded.IsCooked() ? static_cast<const void*>(cooked.data.data()) : image.pixels.get()};
+    const auto size {static_cast<GLsizeiptr>(decoded.GetByteSize())};
+    const auto allocation {m_uploadBuffer->Allocate(size, 4)};
+
+    // Texels either come from the unpack buffer, addressed by offset, or straight from CPU memory.
+    const void* texels {source};
+    if (allocation)
+    {
+        std::memcpy(allocation.data, source, static_cast<std::size_t>(size));
+        m_uploadBuffer->Commit(allocation);
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadBuffer->GetID());
+        texels = reinterpret_cast<const void*>(allocation.offset);
+    }
+
+    if (decoded.IsCooked())
+    {
+        texture.m_texture = std::make_unique<Texture2D>(cooked, static_cast<const std::byte*>(texels), texture.m_textureSlot, texture.m_params);
+    }
+    else
+    {
+        texture.m_texture = std::make_unique<Texture2D>(image.width, image.height, image.channels, texels, texture.m_textureSlot, texture.m_params);
+    }
+
+    if (allocation)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    texture.m_status.store(AsyncTexture::Status::Ready, std::memory_order_release);
+}
+
+std::size_t TextureLoader::GetPendingCount() const noexcept
+{
+    return m_pending.load();
+}
+
+/*
+* Joins the workers and releases GL objects, must run before the context is destroyed. Handles
+* still held elsewhere keep their textures; loading again starts the loader back up.
+*/
+void TextureLoader::Shutdown()
+{
+    m_workers.clear();
+
+    m_requests.clear();
+    m_decoded.clear();
+    m_ready.clear();
+    m_textures.clear();
+    m_pending = 0;
+
+    m_uploadBuffer.reset();
+    m_placeholder.reset();
+}
+}// namespace Renderer
@@ -0,0 +1,129 @@
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "renderer/StreamBuffer.h"
+#include "renderer/Texture2D.h"
+
+namespace Renderer
+{
+/*
+* A texture that may still be loading. Until the real texture is uploaded GetID() returns the
+* loader's placeholder, so callers can draw with it from the first frame.
+*/
+class AsyncTexture
+{
+public:
+
+    enum class Status
+    {
+        Pending,
+        Ready,
+        Failed,
+    };
+
+private:
+
+    friend class TextureLoader;
+
+    std::filesystem::path m_path;
+    GLint m_textureSlot;
+    TextureParams m_params;
+    GLuint m_placeholder;
+
+    std::atomic<Status> m_status;
+    std::unique_ptr<Texture2D> m_texture; // set on the main thread once uploaded.
+
+public:
+
+    AsyncTexture(std::filesystem::path path, int textureSlot, TextureParams params, GLuint placeholder);
+
+    GLuint GetID() const noexcept;
+    GLint GetTextureSlot() const noexcept;
+    Status GetStatus() const noexcept;
+    bool IsReady() const noexcept;
+
+    const std::filesystem::path& GetPath() const noexcept;
+    const Texture2D* GetTexture() const noexcept;
+};
+
+using TextureHandle = std::shared_ptr<AsyncTexture>;
+
+/*
+* Process-wide texture loader. Files are decoded by worker threads, or just read when a cooked
+* '.g9tex' is available; Update(), called once per frame on the main thread, copies the texels into a streamed GL_PIXEL_UNPACK_BUFFER and creates the
+* textures from it, so glTexImage2D returns without waiting on the copy. Uploads are limited per
+* frame to keep a burst of loads from turning into a hitch. Requests for a path that is already
+* loading or loaded return the same handle.
+*/
+class TextureLoader
+{
+private:
+
+    // Either decoded pixels or a cooked file read as is.
+    struct Decoded
+    {
+        TextureHandle texture;
+        Image image;
+        CookedImage cooked;
+
+        bool IsCooked() const noexcept {return !cooked.data.empty();}
+        std::size_t GetByteSize() const noexcept {return IsCooked() ? cooked.data.size() : image.GetByteSize();}
+    };
+
+    // Main thread only.
+    std::unordered_map<std::string, std::weak_ptr<AsyncTexture>> m_textures;
+    std::unique_ptr<StreamBuffer> m_uploadBuffer;
+    std::deque<Decoded> m_ready;
+    std::unique_ptr<Texture2D> m_placeholder;
+
+    // Requested textures not yet uploaded or failed.
+    std::atomic<std::size_t> m_pending;
+
+    // Shared with the workers, guarded by m_mutex.
+    std::mutex m_mutex;
+    std::condition_variable_any m_wake;
+    std::deque<TextureHandle> m_requests;
+    std::vector<Decoded> m_decoded;
+
+    // Declared last so workers are joined before the state they use is destroyed.
+    std::vector<std::jthread> m_workers;
+
+    TextureLoader();
+
+    void Initialize();
+    void WorkerLoop(std::stop_token stop);
+    void Upload(Decoded& decoded);
+
+public:
+
+    static TextureLoader& Instance();
+
+    ~TextureLoader() = default;
+
+    TextureLoader(const TextureLoader&)            = delete;
+    TextureLoader& operator=(const TextureLoader&) = delete;
+
+    TextureHandle Load(const std::filesystem::path& texturePath, int textureSlot = 0, TextureParams params = {});
+
+    void Update();
+
+    std::size_t GetPendingCount() const noexcept;
+
+    void Shutdown();
+};
+}// namespace Renderer
+#endif
@@ -0,0 +1,56 @@
+#include "renderer/TextureUnits.h"
+
+#include <algorithm>
+
+namespace Renderer
+{
+TextureUnitAllocator::TextureUnitAllocator(GLint capacity):
+m_capacity(std::max(capacity, 1))
+{
+    m_textures.reserve(static_cast<std::size_t>(m_capacity));
+}
+
+/*
+* Returns the unit {texture} is bound to for this batch, or -1 when every unit is taken.
+*/
+GLint TextureUnitAllocator::Acquire(GLuint texture)
+{
+    if (auto iter {std::ranges::find(m_textures, texture)}; iter != m_textures.end())
+    {
+        return static_cast<GLint>(iter - m_textures.begin());
+    }
+
+    if (static_cast<GLint>(m_textures.size()) == m_capacity)
+    {
+        return -1;
+    }
+
+    m_textures.push_back(texture);
+    return static_cast<GLint>(m_textures.size()) - 1;
+}
+
+void TextureUnitAllocator::Reset() noexcept
+{
+    m_textures.clear();
+}
+
+std::span<const GLuint> TextureUnitAllocator::GetTextures() const noexcept
+{
+    return m_textures;
+}
+
+GLint TextureUnitAllocator::GetCapacity() const noexcept
+{
+    return m_capacity;
+}
+
+/*
+* Texture units a fragment shader can sample from, at least 16 on GL 3.3.
+*/
+GLint TextureUnitAllocator::QueryUnitLimit()
+{
+    GLint units {0};
+    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &units);
+    return units;
+}
+}// namespace Renderer
@@ -0,0 +1,36 @@
+#ifndef TEXTUREUNITS_H
+#define TEXTUREUNITS_H
+
+#include <span>
+#include <vector>
+
+#include <GL/glew.h>
+
+namespace Renderer
+{
+/*
+* Hands out texture units 0..capacity-1 to the textures of one batch: a texture already in the
+* batch keeps its unit, a new one takes the next free unit. Acquire() returning -1 means the batch
+* is full and has to be drawn before Reset().
+*/
+class TextureUnitAllocator
+{
+private:
+
+    std::vector<GLuint> m_textures; // indexed by unit.
+    GLint m_capacity;
+
+public:
+
+    explicit TextureUnitAllocator(GLint capacity);
+
+    GLint Acquire(GLuint texture);
+    void Reset() noexcept;
+
+    std::span<const GLuint> GetTextures() const noexcept;
+    GLint GetCapacity() const noexcept;
+
+    static GLint QueryUnitLimit();
+};
+}// namespace Renderer
+#endif
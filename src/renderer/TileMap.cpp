@@ -0,0 +1,165 @@
+#include "renderer/TileMap.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+namespace Renderer
+{
+/*
+* @params:
+* size: map width and height in tiles.
+* textureSlot: texture unit the index texture is bound to when drawing.
+* fill: tile index every cell starts with.
+*/
+TileMap::TileMap(glm::ivec2 size, int textureSlot, std::uint16_t fill):
+m_ID(0),
+m_textureSlot(textureSlot),
+m_size(size),
+m_tiles(static_cast<std::size_t>(size.x) * size.y, fill),
+m_dirtyMinRow(std::numeric_limits<int>::max()),
+m_dirtyMaxRow(-1),
+m_version(0)
+{
+    assert(m_size.x > 0 && m_size.y > 0);
+
+    glGenTextures(1, &m_ID);
+    if (!m_ID)
+    {
+        throw std::runtime_error("TileMap: failed to create texture.");
+    }
+
+    glActiveTexture(GL_TEXTURE0 + m_textureSlot);
+    glBindTexture(GL_TEXTURE_2D, m_ID);
+
+    // Integer textures cannot be filtered, tiles are read with texelFetch.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R16UI, m_size.x, m_size.y, 0, GL_RED_INTEGER, GL_UNSIGNED_SHORT, m_tiles.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+TileMap::~TileMap()
+{
+    if (m_ID != 0)
+    {
+        glDeleteTextures(1, &m_ID);
+    }
+}
+
+/*
+* Changes a tile on the CPU copy, visible to the GPU after the next Upload().
+*/
+void TileMap::SetTile(int x, int y, std::uint16_t tile) noexcept
+{
+    assert(x >= 0 && x < m_size.x && y >= 0 && y < m_size.y);
+
+    m_tiles[static_cast<std::size_t>(y) * m_size.x + x] = tile;
+    MarkDirty(y, y);
+}
+
+std::uint16_t TileMap::GetTile(int x, int y) const noexcept
+{
+    assert(x >= 0 && x < m_size.x && y >= 0 && y < m_size.y);
+    return m_tiles[static_cast<std::size_t>(y) * m_size.x + x];
+}
+
+/*
+* Copies a block of tiles, row by row from the bottom, into the map.
+*
+* @params:
+* origin: bottom-left tile of the block.
+* size: block width and height in tiles, {tiles} holds size.x * size.y entries.
+*/
+void TileMap::SetRegion(glm::ivec2 origin, glm::ivec2 size, std::span<const std::uint16_t> tiles) noexcept
+{
+    assert(origin.x >= 0 && origin.y >= 0 && origin.x + size.x <= m_size.x && origin.y + size.y <= m_size.y);
+    assert(tiles.size() == static_cast<std::size_t>(size.x) * size.y);
+
+    for (int row {0}; row < size.y; ++row)
+    {
+        const auto source {tiles.subspan(static_cast<std::size_t>(row) * size.x, size.x)};
+        std::copy(source.begin(), source.end(), m_tiles.begin() + static_cast<std::size_t>(origin.y + row) * m_size.x + origin.x);
+    }
+    MarkDirty(origin.y, origin.y + size.y - 1);
+}
+
+/*
+* Sets every tile of a block to {tile}.
+*/
+void TileMap::FillRegion(glm::ivec2 origin, glm::ivec2 size, std::uint16_t tile) noexcept
+{
+    assert(origin.x >= 0 && origin.y >= 0 && origin.x + size.x <= m_size.x && origin.y + size.y <= m_size.y);
+
+    for (int row {0}; row < size.y; ++row)
+    {
+        auto first {m_tiles.begin() + static_cast<std::size_t>(origin.y + row) * m_size.x + origin.x};
+        std::fill(first, first + size.x, tile);
+    }
+    MarkDirty(origin.y, origin.y + size.y - 1);
+}
+
+void TileMap::MarkDirty(int firstRow, int lastRow) noexcept
+{
+    m_dirtyMinRow = std::min(m_dirtyMinRow, firstRow);
+    m_dirtyMaxRow = std::max(m_dirtyMaxRow, lastRow);
+}
+
+/*
+* Uploads the band of rows edited since the last call, does nothing when no tile changed.
+*/
+void TileMap::Upload()
+{
+    if (m_dirtyMinRow > m_dirtyMaxRow)
+    {
+        return;
+    }
+
+    const int rows {m_dirtyMaxRow - m_dirtyMinRow + 1};
+    const auto* first {m_tiles.data() + static_cast<std::size_t>(m_dirtyMinRow) * m_size.x};
+
+    glActiveTexture(GL_TEXTURE0 + m_textureSlot);
+    glBindTexture(GL_TEXTURE_2D, m_ID);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_dirtyMinRow, m_size.x, rows, GL_RED_INTEGER, GL_UNSIGNED_SHORT, first);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    m_dirtyMinRow = std::numeric_limits<int>::max();
+    m_dirtyMaxRow = -1;
+    ++m_version;
+}
+
+GLuint TileMap::GetID() const noexcept
+{
+    return m_ID;
+}
+
+GLint TileMap::GetTextureSlot() const noexcept
+{
+    return m_textureSlot;
+}
+
+glm::ivec2 TileMap::GetSize() const noexcept
+{
+    return m_size;
+}
+
+/*
+* Changes whenever uploaded tiles change, lets views of the map tell when they are stale.
+*/
+std::uint32_t TileMap::GetVersion() const noexcept
+{
+    return m_version;
+}
+}// namespace Renderer
@@ -0,0 +1,61 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+namespace Renderer
+{
+/*
+* Grid of tile indices kept in an integer texture (GL_R16UI, one texel per tile) so a fragment
+* shader can look tiles up with texelFetch and sample them from an atlas. Two bytes per tile,
+* a 1024x1024 map is 2 MB of texture memory. Edits are made on a CPU copy and uploaded in one
+* batch of rows by Upload().
+*/
+class TileMap
+{
+private:
+
+    GLuint m_ID;
+    GLint  m_textureSlot;
+
+    glm::ivec2 m_size;
+    std::vector<std::uint16_t> m_tiles;
+
+    // Rows edited since the last upload, empty when minRow > maxRow.
+    int m_dirtyMinRow;
+    int m_dirtyMaxRow;
+
+    std::uint32_t m_version; // bumped by every Upload() that changed the texture.
+
+    void MarkDirty(int firstRow, int lastRow) noexcept;
+
+public:
+
+    TileMap(glm::ivec2 size, int textureSlot, std::uint16_t fill = 0);
+    ~TileMap();
+
+    TileMap(const TileMap&)            = delete;
+    TileMap& operator=(const TileMap&) = delete;
+    TileMap(TileMap&&)                 = delete;
+    TileMap& operator=(TileMap&&)      = delete;
+
+    void SetTile(int x, int y, std::uint16_t tile) noexcept;
+    std::uint16_t GetTile(int x, int y) const noexcept;
+
+    void SetRegion(glm::ivec2 origin, glm::ivec2 size, std::span<const std::uint16_t> tiles) noexcept;
+    void FillRegion(glm::ivec2 origin, glm::ivec2 size, std::uint16_t tile) noexcept;
+
+    void Upload();
+
+    GLuint GetID() const noexcept;
+    GLint GetTextureSlot() const noexcept;
+    glm::ivec2 GetSize() const noexcept;
+    std::uint32_t GetVersion() const noexcept;
+};
+}// namespace Renderer
+#endif
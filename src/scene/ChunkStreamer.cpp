@@ -0,0 +1,254 @@
+#include "scene/ChunkStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <ranges>
+
+namespace OceanMap
+{
+namespace
+{
+    // Rings of chunks requested beyond the view, and the wider ring a chunk must leave to be evicted.
+    constexpr int k_PrefetchRings {1};
+    constexpr int k_EvictRings    {2};
+
+    // Finished chunks copied into the tile map per frame, spreads uploads when many arrive at once.
+    constexpr std::size_t k_IntegratesPerFrame {8};
+
+    /*
+    * Integer hash of a world tile, the same tile always gets the same variant.
+    */
+    std::uint32_t HashTile(int x, int y) noexcept
+    {
+        std::uint32_t hash {static_cast<std::uint32_t>(x) * 0x8DA6B343u ^ static_cast<std::uint32_t>(y) * 0xD8163841u};
+        hash ^= hash >> 15;
+        hash *= 0x2C1B3C6Du;
+        hash ^= hash >> 12;
+        hash *= 0x297A2D39u;
+        hash ^= hash >> 15;
+        return hash;
+    }
+}// anonymous namespace
+
+bool ChunkStreamer::Range::Contains(const ChunkCoord& coord) const noexcept
+{
+    return coord.x >= min.x && coord.x <= max.x && coord.y >= min.y && coord.y <= max.y;
+}
+
+/*
+* @params:
+* textureSlot: texture unit of the tile index texture.
+* tileSize: world units per tile.
+* tileVariants: tiles in the atlas, generated tiles are in [0, tileVariants).
+*/
+ChunkStreamer::ChunkStreamer(int textureSlot, float tileSize, std::uint16_t tileVariants):
+m_tileMap(glm::ivec2(k_SlotsPerSide * k_ChunkTiles), textureSlot, k_UnloadedTile),
+m_chunkWorldSize(tileSize * k_ChunkTiles),
+m_tileVariants(std::max<std::uint16_t>(tileVariants, 1)),
+m_worker([this](std::stop_token stop){WorkerLoop(stop);})
+{}
+
+/*
+* Chunks covering {viewRect} widened by {rings} chunks on every side.
+*/
+ChunkStreamer::Range ChunkStreamer::ViewRange(const glm::vec4& viewRect, int rings) const noexcept
+{
+    const glm::ivec2 min {glm::floor(glm::vec2(viewRect.x, viewRect.y) / m_chunkWorldSize)};
+    const glm::ivec2 max {glm::floor(glm::vec2(viewRect.z, viewRect.w) / m_chunkWorldSize)};
+
+    return Range{min - rings, max + rings};
+}
+
+/*
+* Bottom-left texel of the chunk's slot in the toroidal tile map.
+*/
+glm::ivec2 ChunkStreamer::SlotOrigin(const ChunkCoord& coord) const noexcept
+{
+    const int slotX {((coord.x % k_SlotsPerSide) + k_SlotsPerSide) % k_SlotsPerSide};
+    const int slotY {((coord.y % k_SlotsPerSide) + k_SlotsPerSide) % k_SlotsPerSide};
+
+    return glm::ivec2(slotX, slotY) * k_ChunkTiles;
+}
+
+/*
+* Streams chunks for the camera's current view, call once per frame before rendering.
+*/
+void ChunkStreamer::Update(const glm::vec4& viewRect)
+{
+    const Range wanted {ViewRange(viewRect, k_PrefetchRings)};
+    Range keep {ViewRange(viewRect, k_EvictRings)};
+
+    // Chunks kept resident must map to distinct slots, shrink the hysteresis ring if the view is huge.
+    keep.max = glm::min(keep.max, keep.min + k_SlotsPerSide - 1);
+
+    const glm::vec2 center {(glm::vec2(wanted.min) + glm::vec2(wanted.max)) * 0.5f};
+
+    std::vector<ChunkCoord> outside;
+    for (const auto& [coord, state]: m_chunks)
+    {
+        if (!keep.Contains(coord))
+        {
+            outside.push_back(coord);
+        }
+    }
+    for (const auto& coord: outside)
+    {
+        Evict(coord);
+    }
+
+    Request(wanted, center);
+    Integrate();
+
+    m_tileMap.Upload();
+}
+
+/*
+* Forgets a chunk, cancelling its request if the worker has not picked it up. Its slot keeps the old
+* tiles until another chunk claims it, which only happens once the chunk is out of view.
+*/
+void ChunkStreamer::Evict(const ChunkCoord& coord)
+{
+    const auto iter {m_chunks.find(coord)};
+    if (iter == m_chunks.end())
+    {
+        return;
+    }
+
+    if (iter->second == ChunkState::Queued)
+    {
+        std::lock_guard lock(m_mutex);
+        std::erase(m_requests, coord);
+    }
+    m_chunks.erase(iter);
+}
+
+/*
+* Queues every missing chunk of the wanted range, nearest to the view's center first. The chunk's
+* slot is cleared so tiles of the chunk that used it before never show.
+*/
+void ChunkStreamer::Request(const Range& wanted, const glm::vec2& center)
+{
+    std::vector<ChunkCoord> missing;
+    for (int y {wanted.min.y}; y <= wanted.max.y; ++y)
+    {
+        for (int x {wanted.min.x}; x <= wanted.max.x; ++x)
+        {
+            if (!m_chunks.contains(ChunkCoord{x, y}))
+            {
+                missing.push_back(ChunkCoord{x, y});
+            }
+        }
+    }
+
+    if (missing.empty())
+    {
+        return;
+    }
+
+    std::ranges::sort(missing, {}, [&center](const ChunkCoord& coord)
+    {
+        return glm::length(glm::vec2(coord.x, coord.y) - center);
+    });
+
+    for (const auto& coord: missing)
+    {
+        m_chunks.emplace(coord, ChunkState::Queued);
+        m_tileMap.FillRegion(SlotOrigin(coord), glm::ivec2(k_ChunkTiles), k_UnloadedTile);
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_requests.insert(m_requests.end(), missing.begin(), missing.end());
+    }
+    m_wake.notify_all();
+}
+
+/*
+* Copies finished chunks into their slots, chunks evicted while being generated are dropped.
+*/
+void ChunkStreamer::Integrate()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        std::ranges::move(m_completed, std::back_inserter(m_ready));
+        m_completed.clear();
+    }
+
+    const std::size_t count {std::min(m_ready.size(), k_IntegratesPerFrame)};
+    for (std::size_t i {0}; i < count; ++i)
+    {
+        auto& chunk {m_ready[i]};
+
+        const auto iter {m_chunks.find(chunk.coord)};
+        if (iter == m_chunks.end() || iter->second != ChunkState::Queued)
+        {
+            continue;
+        }
+
+        m_tileMap.SetRegion(SlotOrigin(chunk.coord), glm::ivec2(k_ChunkTiles), chunk.tiles);
+        iter->second = ChunkState::Resident;
+    }
+
+    m_ready.erase(m_ready.begin(), m_ready.begin() + static_cast<std::ptrdiff_t>(count));
+}
+
+void ChunkStreamer::WorkerLoop(std::stop_token stop)
+{
+    while (true)
+    {
+        ChunkCoord coord;
+        {
+            std::unique_lock lock(m_mutex);
+            if (!m_wake.wait(lock, stop, [this]{return !m_requests.empty();}))
+            {
+                return;
+            }
+
+            coord = m_requests.front();
+            m_requests.pop_front();
+        }
+
+        auto chunk {GenerateChunk(coord)};
+
+        std::lock_guard lock(m_mutex);
+        m_completed.push_back(std::move(chunk));
+    }
+}
+
+/*
+* Runs on the worker thread, must not touch GL or main thread state.
+*/
+Chunk ChunkStreamer::GenerateChunk(ChunkCoord coord) const
+{
+    Chunk chunk {coord, std::vector<std::uint16_t>(k_ChunkTiles * k_ChunkTiles)};
+
+    const int originX {coord.x * k_ChunkTiles};
+    const int originY {coord.y * k_ChunkTiles};
+
+    for (int y {0}; y < k_ChunkTiles; ++y)
+    {
+        for (int x {0}; x < k_ChunkTiles; ++x)
+        {
+            chunk.tiles[y * k_ChunkTiles + x] = static_cast<std::uint16_t>(HashTile(originX + x, originY + y) % m_tileVariants);
+        }
+    }
+
+    return chunk;
+}
+
+const Renderer::TileMap& ChunkStreamer::GetTileMap() const noexcept
+{
+    return m_tileMap;
+}
+
+std::size_t ChunkStreamer::GetResidentCount() const noexcept
+{
+    return static_cast<std::size_t>(std::ranges::count(m_chunks | std::views::values, ChunkState::Resident));
+}
+
+std::size_t ChunkStreamer::GetPendingCount() const noexcept
+{
+    return m_chunks.size() - GetResidentCount();
+}
+}// namespace OceanMap
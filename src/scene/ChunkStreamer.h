@@ -0,0 +1,128 @@
+#ifndef CHUNKSTREAMER_H
+#define CHUNKSTREAMER_H
+
+#include <compare>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "renderer/TileMap.h"
+
+namespace OceanMap
+{
+struct ChunkCoord
+{
+    int x;
+    int y;
+
+    auto operator<=>(const ChunkCoord&) const = default;
+};
+
+struct ChunkCoordHash
+{
+    std::size_t operator()(const ChunkCoord& coord) const noexcept
+    {
+        const std::uint64_t key {(static_cast<std::uint64_t>(static_cast<std::uint32_t>(coord.x)) << 32) | static_cast<std::uint32_t>(coord.y)};
+        return std::hash<std::uint64_t>{}(key);
+    }
+};
+
+// Tile data for one chunk, produced on the worker thread.
+struct Chunk
+{
+    ChunkCoord coord;
+    std::vector<std::uint16_t> tiles; // k_ChunkTiles * k_ChunkTiles, bottom row first.
+};
+
+/*
+* Streams an unbounded ocean in fixed-size chunks around the camera. Chunks inside the view plus a
+* prefetch ring are requested from a worker thread that generates their tiles; finished chunks are
+* copied into a toroidal tile texture, chunk (x, y) always lands in slot (x mod N, y mod N), so the
+* resident window scrolls without moving data. Chunks are only evicted once they fall outside a
+* second, wider ring (hysteresis), so panning back and forth across a chunk border does not
+* regenerate chunks. The tile map is the only storage: tiles are not kept once copied into their
+* slot, and the keep ring is clamped to k_SlotsPerSide chunks per side so no two resident chunks
+* share a slot.
+*
+* Slots whose chunk is not loaded yet hold k_UnloadedTile, which the shader draws as open water.
+*/
+class ChunkStreamer
+{
+public:
+
+    static constexpr int k_ChunkTiles {16};
+    static constexpr int k_SlotsPerSide {16};
+
+    static constexpr std::uint16_t k_UnloadedTile {0xFFFF};
+
+private:
+
+    enum class ChunkState
+    {
+        Queued,
+        Resident,
+    };
+
+    struct Range
+    {
+        glm::ivec2 min;
+        glm::ivec2 max;
+
+        bool Contains(const ChunkCoord& coord) const noexcept;
+    };
+
+    Renderer::TileMap m_tileMap;
+
+    float m_chunkWorldSize;
+    std::uint16_t m_tileVariants;
+
+    std::unordered_map<ChunkCoord, ChunkState, ChunkCoordHash> m_chunks;
+
+    // Shared with the worker, guarded by m_mutex.
+    std::mutex m_mutex;
+    std::condition_variable_any m_wake;
+    std::deque<ChunkCoord> m_requests;
+    std::vector<Chunk> m_completed;
+
+    std::vector<Chunk> m_ready; // main thread copy of m_completed.
+
+    // Declared last so the worker is joined before the state it uses is destroyed.
+    std::jthread m_worker;
+
+    Range ViewRange(const glm::vec4& viewRect, int rings) const noexcept;
+    glm::ivec2 SlotOrigin(const ChunkCoord& coord) const noexcept;
+
+    void Evict(const ChunkCoord& coord);
+    void Request(const Range& wanted, const glm::vec2& center);
+    void Integrate();
+
+    void WorkerLoop(std::stop_token stop);
+    Chunk GenerateChunk(ChunkCoord coord) const;
+
+public:
+
+    ChunkStreamer(int textureSlot, float tileSize, std::uint16_t tileVariants);
+    ~ChunkStreamer() = default;
+
+    ChunkStreamer(const ChunkStreamer&)            = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+    ChunkStreamer(ChunkStreamer&&)                 = delete;
+    ChunkStreamer& operator=(ChunkStreamer&&)      = delete;
+
+    void Update(const glm::vec4& viewRect);
+
+    const Renderer::TileMap& GetTileMap() const noexcept;
+
+    std::size_t GetResidentCount() const noexcept;
+    std::size_t GetPendingCount() const noexcept;
+};
+}// namespace OceanMap
+#endif
@@ -1,16 +1,15 @@
 #include "OceanMap.h"
 
-#include <cmath>
+#include <algorithm>
 #include <cstddef>
 #include <filesystem>
-#include <array>
-#include <vector>
+#include <cstdint>
+#include <limits>
+#include <thread>
 
-#include <glm/ext/matrix_transform.hpp>
-#include <glm/ext/matrix_clip_space.hpp>
-
-#include "entity/PlayerBoat.h"
-#include "renderer/Texture2D.h"
+#include "renderer/DebugDraw.h"
+#include "renderer/GeometryRegistry.h"
+#include "renderer/TextureLoader.h"
 
 
 namespace OceanMap
@@ -21,123 +20,182 @@ namespace
     const std::filesystem::path k_FragShader  {"resources/shaders/oceanmap.frag"};
     const std::filesystem::path k_TexturePath {"resources/images/oceantile.png"};
 
-    constexpr int k_TextureIndex {0};
+    constexpr int k_AtlasIndex   {0};
+    constexpr int k_TileMapIndex {2};
+    constexpr int k_CacheIndex   {0};
+    constexpr int k_WakeIndex    {1};
 
-    constexpr std::array<OceanMapComposite::Vertex, 6> k_QuadVertices =
-    {{
-         {{-64.0f, 64.0f},  {0.0f, 1.0f}},// top-left
-         {{-64.0f, -64.0f}, {0.0f, 0.0f}},// bot-left
-         {{64.0f, -64.0f},  {1.0f, 0.0f}},// bot-right
-         {{64.0f, 64.0f},   {1.0f, 1.0f}},// top-right
-    }};
+    constexpr std::size_t k_MaxWakeParticles {131072};
+    constexpr unsigned int k_MaxWakeWorkers  {4};
+    constexpr glm::vec4 k_WakeColor {0.9f, 0.95f, 1.0f, 1.0f};
 
-    constexpr std::array<GLuint, 6> k_IndexBuffer =
-    {
-        0, 1, 2, 2, 3, 0
-    };
+    // The ocean is behind everything in its layer, then wakes, then the boats which submit at their y.
+    constexpr float k_OceanDepth {std::numeric_limits<float>::infinity()};
+    constexpr float k_WakeDepth  {std::numeric_limits<float>::max()};
+
+    constexpr float k_TileSize {128.0f};                // world units per tile.
+    constexpr glm::ivec2 k_AtlasGrid {1, 1};            // tiles per atlas row and column.
 }// anonymous namespace
 
-OceanMapComposite::OceanMapComposite(std::string name):
+OceanMapComposite::OceanMapComposite(std::shared_ptr<Renderer::CameraBuffer> camera, std::string name):
     World::CompositeComponent(0, std::move(name)),
     m_shader(k_VertShader, k_FragShader),
-    m_texture(k_TexturePath, k_TextureIndex)
+    m_atlas(Renderer::TextureLoader::Instance().Load(k_TexturePath, k_AtlasIndex)),
+    m_streamer(k_TileMapIndex, k_TileSize, static_cast<std::uint16_t>(k_AtlasGrid.x * k_AtlasGrid.y)),
+    m_VAO(Renderer::GeometryRegistry::Instance().GetVertexArray(Renderer::Mesh::ScreenQuad)),
+    m_cache(k_CacheIndex, k_TileSize),
+    m_cached(true),
+    m_camera(std::move(camera)),
+    m_wakeParticles(k_MaxWakeParticles),
+    m_wakeRenderer(k_MaxWakeParticles, k_WakeIndex)
 {
-    glGenVertexArrays(1, &m_VAO);
-    glBindVertexArray(m_VAO);
-
-    glGenBuffers(1, &m_VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(OceanMapComposite::Vertex) * k_QuadVertices.size(), k_QuadVertices.data(), GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, positions)));
-    glEnableVertexAttribArray(0);
+    m_shader.Bind();
 
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, texcoords)));
-    glEnableVertexAttribArray(1);
+    m_shader.SetUniform1i("u_Atlas", k_AtlasIndex);
+    m_shader.SetUniform1i("u_TileMap", k_TileMapIndex);
+    m_shader.SetUniform1f("u_TileSize", k_TileSize);
+    m_shader.SetUniform2i("u_AtlasGrid", k_AtlasGrid.x, k_AtlasGrid.y);
 
-    glGenBuffers(1, &m_EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * k_IndexBuffer.size(), k_IndexBuffer.data(), GL_STATIC_DRAW);
+    m_shader.UnBind();
 
-    GenerateTranslations();
+    // Add boat children.
+    m_player = std::make_shared<Entity::PlayerBoat>("thechurchofbob", glm::vec3(512.0f, 512.0f, 0.0f));
+    World::CompositeComponent::AddChildren(m_player);
 
-    glGenBuffers(1, &m_instanceVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Instances) * m_translations.size(), m_translations.data(), GL_STATIC_DRAW);
+    // Only splits once the pool is large, see ParticlePool::k_MinParallelCount.
+    m_wakeParticles.SetWorkerCount(std::clamp(std::thread::hardware_concurrency(), 2u, k_MaxWakeWorkers + 1) - 1);
+    m_wakeRenderer.SetColor(k_WakeColor);
+    m_wakeEmitters.emplace_back(m_player);
+}
 
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Instances), reinterpret_cast<void*>(offsetof(Instances, translation)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribDivisor(2, 1);
+void OceanMapComposite::OnEvent(Event::Event& event)
+{
+    World::CompositeComponent::OnEvent(event);
+}
 
-    auto model = glm::mat4(1.0f);
-    auto projection = glm::ortho(0.0f, 1024.0f, 0.0f, 1024.0f, -.1f, 100.0f);
-    auto view = glm::lookAt
-        (
-         glm::vec3(0.0f, 0.0f, 50.0f),
-         glm::vec3(0.0f, 0.0f, 0.0f),
-         glm::vec3(0.0f, 1.0f, 0.0f)
-        );
+/*
+ * Centers the camera on the player once boats have moved, then streams chunks for the new view.
+ * Wakes are emitted from the boats' new positions and uploaded for this frame.
+ */
+void OceanMapComposite::OnUpdate(float deltaSeconds)
+{
+    World::CompositeComponent::OnUpdate(deltaSeconds);
 
-    m_shader.Bind();
-    m_texture.Bind();
+    const glm::vec2 player {m_player->GetPosition()};
+    m_camera->SetPosition(player - m_camera->GetViewport() * 0.5f);
 
-    m_shader.SetUniformMat4f("u_Model", model);
-    m_shader.SetUniformMat4f("u_Projection", projection);
-    m_shader.SetUniformMat4f("u_View", view);
-    m_shader.SetUniform1i("u_Texture", k_TextureIndex);
+    const auto viewRect {m_camera->GetViewRect()};
+    m_streamer.Update(viewRect);
 
-    m_shader.UnBind();
+    if (m_cached && !m_cache.IsCurrent(viewRect, GetContentKey()))
+    {
+        DrawOcean(m_cache.Begin(viewRect, GetContentKey()));
+        m_cache.End();
+    }
 
-    // Add boat children.
-    World::CompositeComponent::AddChildren(std::make_shared<Entity::PlayerBoat>("thechurchofbob", glm::vec3(512.0f, 512.0f, 0.0f)));
+    std::erase_if(m_wakeEmitters, [](const WakeEmitter& emitter) {return emitter.IsExpired();});
+    for (auto& emitter : m_wakeEmitters)
+    {
+        emitter.Emit(deltaSeconds, m_wakeParticles);
+    }
+    m_wakeParticles.Update(deltaSeconds);
+    m_wakeRenderer.Upload(m_wakeParticles);
 }
 
-OceanMapComposite::~OceanMapComposite()
+/*
+ * One quad covers the screen whatever the world size, either the cached ocean or the tilemap pass
+ * itself. Ocean is submitted as opaque, farthest in this layer, so boats and wakes pass the depth test over it.
+ */
+void OceanMapComposite::OnRender(Renderer::RenderQueue& queue) const
 {
-    glDeleteBuffers(1, &m_instanceVBO);
-    glDeleteBuffers(1, &m_EBO);
-    glDeleteBuffers(1, &m_VBO);
-    glDeleteVertexArrays(1, &m_VAO);
+    if (m_cached)
+    {
+        m_cache.Submit(queue, k_OceanDepth, false);
+    }
+    else
+    {
+        const auto& tileMap {m_streamer.GetTileMap()};
+        const auto& viewRect {queue.GetViewRect()};
+
+        // Only this draw uses the shader, the uniform holds until the queue executes.
+        m_shader.Bind();
+        m_shader.SetUniform4f("u_WorldRect", viewRect.x, viewRect.y, viewRect.z, viewRect.w);
+
+        Renderer::RenderCommand command
+        {
+            .shader         = &m_shader,
+            .texture        = m_atlas->GetID(),
+            .textureSlot    = m_atlas->GetTextureSlot(),
+            .vertexArray    = m_VAO,
+            .indexCount     = Renderer::GeometryRegistry::k_IndicesPerQuad,
+            .auxTexture     = tileMap.GetID(),
+            .auxTextureSlot = tileMap.GetTextureSlot(),
+            .coversView     = true,
+        };
+        queue.Submit(command, k_OceanDepth, false);
+    }
+
+    m_wakeRenderer.Submit(queue, k_WakeDepth);
+
+    // Streaming chunk boundaries and the area the cache covers.
+    Renderer::DebugDraw::Grid(queue.GetViewRect(), k_TileSize * ChunkStreamer::k_ChunkTiles, Renderer::PackColor(0, 160, 255, 160));
+    if (m_cached)
+    {
+        Renderer::DebugDraw::Box(m_cache.GetRect(), Renderer::PackColor(255, 0, 255));
+    }
+
+    World::CompositeComponent::OnRender(queue);
 }
 
-void OceanMapComposite::OnEvent(Event::Event& event)
+/*
+ * Boats still moving, chunks around the view still streaming in, or wakes still fading.
+ */
+bool OceanMapComposite::NeedsRedraw() const
 {
-    World::CompositeComponent::OnEvent(event);
+    return World::CompositeComponent::NeedsRedraw() || m_streamer.GetPendingCount() > 0 || m_wakeParticles.GetCount() > 0;
 }
 
-void OceanMapComposite::OnUpdate(float deltaSeconds)
+/*
+ * Off: the tilemap pass runs every frame. Useful to compare fill cost.
+ */
+void OceanMapComposite::SetCaching(bool enabled) noexcept
 {
-    World::CompositeComponent::OnUpdate(deltaSeconds);
+    m_cached = enabled;
+    m_cache.Invalidate();
 }
 
-void OceanMapComposite::OnRender() const
+/*
+ * Draws the tilemap pass straight away over {worldRect}, into whatever framebuffer is bound.
+ * Blending is off so the cache stores the ocean's colors as they are.
+ */
+void OceanMapComposite::DrawOcean(const glm::vec4& worldRect) const
 {
+    const auto& tileMap {m_streamer.GetTileMap()};
+
     m_shader.Bind();
+    m_shader.SetUniform4f("u_WorldRect", worldRect.x, worldRect.y, worldRect.z, worldRect.w);
+
+    glActiveTexture(GL_TEXTURE0 + m_atlas->GetTextureSlot());
+    glBindTexture(GL_TEXTURE_2D, m_atlas->GetID());
+    glActiveTexture(GL_TEXTURE0 + tileMap.GetTextureSlot());
+    glBindTexture(GL_TEXTURE_2D, tileMap.GetID());
+
+    glDisable(GL_BLEND);
     glBindVertexArray(m_VAO);
-    glDrawElementsInstanced(GL_TRIANGLES, k_IndexBuffer.size(), GL_UNSIGNED_INT, nullptr, m_translations.size());
+    glDrawElements(GL_TRIANGLES, Renderer::GeometryRegistry::k_IndicesPerQuad, GL_UNSIGNED_INT, nullptr);
     glBindVertexArray(0);
-    m_shader.UnBind();
+    glEnable(GL_BLEND);
 
-    World::CompositeComponent::OnRender();
+    m_shader.UnBind();
 }
 
-void OceanMapComposite::GenerateTranslations()
+/*
+ * Changes whenever the cached ocean would look different: new tiles streamed in, or the atlas
+ * swapping its placeholder for the loaded texture.
+ */
+std::uint64_t OceanMapComposite::GetContentKey() const noexcept
 {
-    const float windowHeight {1024.0f};
-    const float windowWidth {1024.0f};
-
-    const float quadSize {128.0f};
-
-    const size_t total {static_cast<size_t>(std::ceil(windowWidth / quadSize))};
-    m_translations.reserve(total * total);
-
-    for (int y {0}; y < windowHeight; y+= quadSize)
-    {
-        for (int x {0}; x < windowWidth; x+=quadSize)
-        {
-            m_translations.emplace_back(Instances{{x + quadSize * 0.5f, y + quadSize *  0.5f}});
-        }
-    }
+    return (static_cast<std::uint64_t>(m_atlas->GetID()) << 32) | m_streamer.GetTileMap().GetVersion();
 }
 
 }// namespace OceanMap
@@ -1,45 +1,60 @@
 #ifndef OCEANMAP_H
 #define OCEANMAP_H
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "core/compositecomponent.h"
+#include "entity/PlayerBoat.h"
+#include "renderer/CameraBuffer.h"
+#include "renderer/LayerCache.h"
+#include "renderer/ParticlePool.h"
+#include "renderer/ParticleRenderer.h"
+#include "renderer/RenderQueue.h"
 #include "renderer/Shader.h"
-#include "renderer/Texture2D.h"
+#include "renderer/TextureLoader.h"
+#include "scene/ChunkStreamer.h"
+#include "scene/WakeEmitter.h"
 
 namespace OceanMap
 {
+/*
+* Ocean drawn as a GPU tilemap: tile indices live in an integer texture and a single
+* screen-covering quad looks them up per fragment and samples the tile atlas. Draw cost depends
+* on screen size rather than map size. Tiles are streamed in chunks around the camera, which
+* follows the player's boat.
+*
+* With caching on (the default) the ocean is rendered into a LayerCache and redrawn only when
+* tiles or the atlas change or the camera leaves the cached margin; other frames draw one
+* textured quad.
+*
+* Boat wakes share one ParticlePool drawn with a single instanced call beneath the boats.
+*/
 class OceanMapComposite final: public World::CompositeComponent
 {
-public:
-
-    struct Vertex
-    {
-        glm::vec2 positions;
-        glm::vec2 texcoords;
-    };
-
-    struct Instances
-    {
-        glm::vec2 translation;
-    };
-
 private:
 
     Renderer::Shader    m_shader;
-    Renderer::Texture2D m_texture;
+    Renderer::TextureHandle m_atlas;
+    ChunkStreamer       m_streamer;
 
-    GLuint m_VAO;
-    GLuint m_VBO;
-    GLuint m_EBO;
-    GLuint m_instanceVBO;
+    GLuint m_VAO; // GeometryRegistry's screen quad.
 
-    std::vector<Instances> m_translations;
+    Renderer::LayerCache m_cache;
+    bool m_cached;
 
-    void GenerateTranslations();
+    std::shared_ptr<Renderer::CameraBuffer> m_camera;
+    std::shared_ptr<Entity::PlayerBoat> m_player;
+
+    Renderer::ParticlePool m_wakeParticles;
+    Renderer::ParticleRenderer m_wakeRenderer;
+    std::vector<WakeEmitter> m_wakeEmitters;
 
 public:
 
-    OceanMapComposite(std::string name = "OceanMap");
-    ~OceanMapComposite();
+    OceanMapComposite(std::shared_ptr<Renderer::CameraBuffer> camera, std::string name = "OceanMap");
+    ~OceanMapComposite() = default;
 
     OceanMapComposite(const OceanMapComposite&)            = delete;
     OceanMapComposite(OceanMapComposite&&) noexcept        = delete;
@@ -48,7 +63,15 @@ public:
 
     void OnEvent(Event::Event& event) override;
     void OnUpdate(float deltaSeconds) override;
-    void OnRender() const override;
+    void OnRender(Renderer::RenderQueue& queue) const override;
+    bool NeedsRedraw() const override;
+
+    void SetCaching(bool enabled) noexcept;
+
+private:
+
+    void DrawOcean(const glm::vec4& worldRect) const;
+    std::uint64_t GetContentKey() const noexcept;
 };
 }// namespace OceanMap
 
@@ -0,0 +1,74 @@
+#include "WakeEmitter.h"
+
+#include <cmath>
+
+namespace OceanMap
+{
+WakeEmitter::WakeEmitter(std::weak_ptr<const World::BoatComponent> boat, const WakeSettings& settings):
+m_boat(std::move(boat)),
+m_settings(settings),
+m_accumulator(0.0f),
+m_seed(0x9E3779B9u)
+{}
+
+/*
+* Xorshift, plenty for foam jitter and cheaper than <random> per particle.
+*/
+float WakeEmitter::Random() noexcept
+{
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    return static_cast<float>(m_seed) / static_cast<float>(0xFFFFFFFFu) * 2.0f - 1.0f;
+}
+
+/*
+* Particles start at the stern, spread across the boat's width, and drift outward from the
+* centreline while the pool's damping slows them down.
+*/
+void WakeEmitter::Emit(float deltaSeconds, Renderer::ParticlePool& pool)
+{
+    const auto boat {m_boat.lock()};
+    if (!boat || boat->GetMaxSpeed() <= 0.0f)
+    {
+        return;
+    }
+
+    const float speed {std::abs(boat->GetSpeed()) / boat->GetMaxSpeed()};
+    m_accumulator += m_settings.rate * speed * deltaSeconds;
+    if (m_accumulator < 1.0f)
+    {
+        return;
+    }
+
+    const glm::vec2 forward {boat->GetForward()};
+    const glm::vec2 side {-forward.y, forward.x};
+    const glm::vec2 stern {glm::vec2{boat->GetPosition()} - forward * m_settings.sternOffset};
+
+    for (; m_accumulator >= 1.0f; m_accumulator -= 1.0f)
+    {
+        const float lateral {Random()};
+
+        Renderer::Particle particle
+        {
+            .position = stern + side * (lateral * m_settings.spread),
+            .velocity = side * (lateral * m_settings.drift) - forward * (boat->GetSpeed() * 0.25f),
+            .lifetime = m_settings.lifetime * (0.75f + 0.25f * Random()),
+            .size     = m_settings.startSize,
+            .growth   = m_settings.growth,
+            .alpha    = m_settings.startAlpha * speed,
+        };
+
+        if (!pool.Emit(particle))
+        {
+            m_accumulator = 0.0f;
+            break;
+        }
+    }
+}
+
+bool WakeEmitter::IsExpired() const noexcept
+{
+    return m_boat.expired();
+}
+}// namespace OceanMap
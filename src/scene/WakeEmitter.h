@@ -0,0 +1,48 @@
+#ifndef WAKEEMITTER_H
+#define WAKEEMITTER_H
+
+#include <cstdint>
+#include <memory>
+
+#include "core/boatcomponent.h"
+#include "renderer/ParticlePool.h"
+
+namespace OceanMap
+{
+struct WakeSettings
+{
+    float rate        {240.0f}; // particles per second at full speed.
+    float lifetime    {2.5f};   // seconds.
+    float spread      {10.0f};  // lateral jitter at the stern, world units.
+    float drift       {12.0f};  // sideways speed pushing the wake apart.
+    float startSize   {10.0f};
+    float growth      {14.0f};  // size gained per second.
+    float startAlpha  {0.6f};
+    float sternOffset {40.0f};  // behind the boat's position.
+};
+
+/*
+* Spawns foam behind a boat into a shared ParticlePool, proportional to how fast the boat moves.
+* Holds the boat weakly; once the boat is gone the emitter stops and the particles fade out.
+*/
+class WakeEmitter
+{
+private:
+
+    std::weak_ptr<const World::BoatComponent> m_boat;
+    WakeSettings m_settings;
+
+    float m_accumulator; // fractional particles carried to the next frame.
+    std::uint32_t m_seed;
+
+    float Random() noexcept; // [-1, 1].
+
+public:
+
+    explicit WakeEmitter(std::weak_ptr<const World::BoatComponent> boat, const WakeSettings& settings = {});
+
+    void Emit(float deltaSeconds, Renderer::ParticlePool& pool);
+    bool IsExpired() const noexcept;
+};
+}// namespace OceanMap
+#endif
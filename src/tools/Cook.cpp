@@ -0,0 +1,157 @@
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <print>
+#include <string_view>
+#include <vector>
+
+#include "renderer/TextureFormat.h"
+#include "tools/PackWriter.h"
+#include "tools/TextureCooker.h"
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::println(stderr,
+            "usage: gamenine-cook [--no-mips] [--compress bc1|bc3] [-o output.g9tex | --output-dir directory] <image>...\n"
+            "       gamenine-cook [--no-mips] [--compress bc1|bc3] --pack output.g9pack <file|directory>...\n"
+            "Writes <image> as a cooked '.g9tex' next to it, under --output-dir at the image's relative\n"
+            "path, or to -o when cooking a single image.\n"
+            "With --pack, stores every file under the inputs in one archive, images also cooked.");
+    }
+
+    /*
+    * Adds {path} to the pack verbatim; PNGs also get their cooked '.g9tex' entry so Texture2D finds
+    * it in the pack without a cooked file on disk.
+    */
+    bool AddToPack(Tools::PackWriter& pack, const Tools::TextureCooker& cooker, const std::filesystem::path& path)
+    {
+        const auto extension {path.extension()};
+        if (extension == ".g9tex" || extension == ".tmp")
+        {
+            return true;
+        }
+
+        if (!pack.AddFile(path))
+        {
+            return false;
+        }
+
+        if (extension == ".png")
+        {
+            auto cooked {cooker.Cook(path)};
+            if (!cooked)
+            {
+                return false;
+            }
+            pack.Add(Renderer::CookedTexturePath(path), std::move(*cooked));
+        }
+
+        return true;
+    }
+
+    bool WritePack(const std::filesystem::path& output, const std::vector<std::filesystem::path>& inputs, const Tools::TextureCooker& cooker)
+    {
+        Tools::PackWriter pack;
+
+        bool succeeded {true};
+        for (const auto& input: inputs)
+        {
+            if (!std::filesystem::is_directory(input))
+            {
+                succeeded = AddToPack(pack, cooker, input) && succeeded;
+                continue;
+            }
+
+            for (const auto& entry: std::filesystem::recursive_directory_iterator(input))
+            {
+                if (entry.is_regular_file())
+                {
+                    succeeded = AddToPack(pack, cooker, entry.path()) && succeeded;
+                }
+            }
+        }
+
+        return succeeded && pack.Write(output);
+    }
+}// anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    Tools::CookOptions options;
+    std::filesystem::path output;
+    std::filesystem::path outputDirectory;
+    std::filesystem::path packOutput;
+    std::vector<std::filesystem::path> inputs;
+
+    for (int i {1}; i < argc; ++i)
+    {
+        const std::string_view argument {argv[i]};
+
+        if (argument == "--no-mips")
+        {
+            options.generateMipmaps = false;
+        }
+        else if (argument == "--compress" && i + 1 < argc)
+        {
+            const std::string_view mode {argv[++i]};
+            if (mode == "bc1")
+            {
+                options.compression = Tools::Compression::BC1;
+            }
+            else if (mode == "bc3")
+            {
+                options.compression = Tools::Compression::BC3;
+            }
+            else
+            {
+                PrintUsage();
+                return EXIT_FAILURE;
+            }
+        }
+        else if (argument == "-o" && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (argument == "--output-dir" && i + 1 < argc)
+        {
+            outputDirectory = argv[++i];
+        }
+        else if (argument == "--pack" && i + 1 < argc)
+        {
+            packOutput = argv[++i];
+        }
+        else if (argument.starts_with("-"))
+        {
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+        else
+        {
+            inputs.emplace_back(argument);
+        }
+    }
+
+    if (inputs.empty() || (!output.empty() && (inputs.size() > 1 || !outputDirectory.empty())))
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    const Tools::TextureCooker cooker(options);
+
+    if (!packOutput.empty())
+    {
+        return WritePack(packOutput, inputs, cooker) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    bool succeeded {true};
+    for (const auto& input: inputs)
+    {
+        const auto destination {output.empty() ? Renderer::CookedTexturePath(input, outputDirectory) : output};
+        succeeded = cooker.CookToFile(input, destination) && succeeded;
+    }
+
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
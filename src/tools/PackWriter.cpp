@@ -0,0 +1,145 @@
+#include "tools/PackWriter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <print>
+
+#include "utility/Hash.h"
+#include "utility/ResourcePack.h"
+
+namespace Tools
+{
+namespace
+{
+    std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}// anonymous namespace
+
+void PackWriter::Add(const std::filesystem::path& name, std::vector<std::byte> contents)
+{
+    auto key {Utility::ResourceKey(name)};
+
+    auto iter {std::ranges::find(m_entries, key, &Entry::name)};
+    if (iter != m_entries.end())
+    {
+        iter->contents = std::move(contents);
+        return;
+    }
+
+    m_entries.emplace_back(std::move(key), std::move(contents));
+}
+
+bool PackWriter::AddFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        std::println(stderr, "Failed to open '{}'.", path.string());
+        return false;
+    }
+
+    std::vector<std::byte> contents(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+    if (!file)
+    {
+        std::println(stderr, "Failed to read '{}'.", path.string());
+        return false;
+    }
+
+    Add(path, std::move(contents));
+    return true;
+}
+
+/*
+* Blobs first, each aligned so cooked texels and GPU-bound data can be used in place, then the
+* table of contents sorted by (hash, name) and the name strings.
+*/
+bool PackWriter::Write(const std::filesystem::path& outputPath)
+{
+    std::ranges::sort(m_entries, [](const Entry& lhs, const Entry& rhs)
+    {
+        const auto lhsHash {Utility::Fnv1a64(lhs.name)};
+        const auto rhsHash {Utility::Fnv1a64(rhs.name)};
+        return lhsHash != rhsHash ? lhsHash < rhsHash : lhs.name < rhs.name;
+    });
+
+    std::vector<Utility::ResourcePackEntry> table;
+    table.reserve(m_entries.size());
+
+    std::string names;
+    std::uint64_t offset {AlignUp(sizeof(Utility::ResourcePackHeader), Utility::k_ResourcePackAlignment)};
+    for (const auto& entry: m_entries)
+    {
+        table.push_back({
+            .pathHash   = Utility::Fnv1a64(entry.name),
+            .offset     = offset,
+            .size       = entry.contents.size(),
+            .nameOffset = static_cast<std::uint32_t>(names.size()),
+            .nameLength = static_cast<std::uint32_t>(entry.name.size()),
+        });
+
+        names += entry.name;
+        offset = AlignUp(offset + entry.contents.size(), Utility::k_ResourcePackAlignment);
+    }
+
+    const Utility::ResourcePackHeader header {
+        .magic         = Utility::k_ResourcePackMagic,
+        .version       = Utility::k_ResourcePackVersion,
+        .entryCount    = static_cast<std::uint32_t>(table.size()),
+        .reserved      = 0,
+        .entriesOffset = offset,
+        .namesOffset   = offset + table.size() * sizeof(Utility::ResourcePackEntry),
+    };
+
+    auto temporary {outputPath};
+    temporary += ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+        auto pad = [&file]()
+        {
+            const auto position {static_cast<std::uint64_t>(file.tellp())};
+            const std::vector<char> zeros(AlignUp(position, Utility::k_ResourcePackAlignment) - position, 0);
+            file.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+        };
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& entry: m_entries)
+        {
+            pad();
+            file.write(reinterpret_cast<const char*>(entry.contents.data()), static_cast<std::streamsize>(entry.contents.size()));
+        }
+        pad();
+        file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(Utility::ResourcePackEntry)));
+        file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+        if (!file)
+        {
+            std::println(stderr, "Failed to write '{}'.", temporary.string());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, outputPath, error);
+    if (error)
+    {
+        std::println(stderr, "Failed to write '{}': {}", outputPath.string(), error.message());
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+
+    return true;
+}
+
+std::size_t PackWriter::GetEntryCount() const noexcept
+{
+    return m_entries.size();
+}
+}// namespace Tools
@@ -0,0 +1,38 @@
+#ifndef PACKWRITER_H
+#define PACKWRITER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Tools
+{
+/*
+* Collects resources in memory and writes them as one '.g9pack' archive, see utility/ResourcePack.h
+* for the layout.
+*/
+class PackWriter
+{
+private:
+
+    struct Entry
+    {
+        std::string name;
+        std::vector<std::byte> contents;
+    };
+
+    std::vector<Entry> m_entries;
+
+public:
+
+    // Adds or replaces {name}, stored under Utility::ResourceKey(name).
+    void Add(const std::filesystem::path& name, std::vector<std::byte> contents);
+    bool AddFile(const std::filesystem::path& path);
+
+    bool Write(const std::filesystem::path& outputPath);
+
+    std::size_t GetEntryCount() const noexcept;
+};
+}// namespace Tools
+#endif
@@ -0,0 +1,404 @@
+#include "tools/TextureCooker.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <print>
+#include <system_error>
+
+#include <stb_image.h>
+
+namespace Tools
+{
+namespace
+{
+    using Renderer::TexelFormat;
+
+    struct Level
+    {
+        std::uint32_t width;
+        std::uint32_t height;
+        std::vector<std::uint8_t> texels;
+    };
+
+    using Block = std::array<std::array<std::uint8_t, 4>, 16>; // 4x4 RGBA texels, row by row.
+
+    // Alpha below this is transparent in BC1's punch-through mode.
+    constexpr std::uint8_t k_AlphaCutoff {128};
+
+    /*
+    * Box filter, odd edges reuse the last row or column.
+    */
+    Level Downsample(const Level& source, int channels)
+    {
+        Level level {std::max(1u, source.width / 2), std::max(1u, source.height / 2), {}};
+        level.texels.resize(static_cast<std::size_t>(level.width) * level.height * channels);
+
+        auto texel = [&source, channels](std::uint32_t x, std::uint32_t y, int channel)
+        {
+            x = std::min(x, source.width - 1);
+            y = std::min(y, source.height - 1);
+            return static_cast<unsigned int>(source.texels[(static_cast<std::size_t>(y) * source.width + x) * channels + channel]);
+        };
+
+        for (std::uint32_t y {0}; y < level.height; ++y)
+        {
+            for (std::uint32_t x {0}; x < level.width; ++x)
+            {
+                for (int channel {0}; channel < channels; ++channel)
+                {
+                    const unsigned int sum {texel(2 * x, 2 * y, channel) + texel(2 * x + 1, 2 * y, channel) +
+                                            texel(2 * x, 2 * y + 1, channel) + texel(2 * x + 1, 2 * y + 1, channel)};
+                    level.texels[(static_cast<std::size_t>(y) * level.width + x) * channels + channel] = static_cast<std::uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        return level;
+    }
+
+    std::uint16_t To565(const std::array<std::uint8_t, 4>& color) noexcept
+    {
+        return static_cast<std::uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+    }
+
+    std::array<int, 3> From565(std::uint16_t color) noexcept
+    {
+        const int r {(color >> 11) & 31};
+        const int g {(color >> 5) & 63};
+        const int b {color & 31};
+        return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+    }
+
+    void WriteLE(std::uint8_t* out, std::uint64_t value, int bytes) noexcept
+    {
+        for (int i {0}; i < bytes; ++i)
+        {
+            out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+    }
+
+    /*
+    * BC1 color block from the bounding box of the block's colors. With {punchThrough}, blocks that
+    * contain transparent texels use the 3-color mode where index 3 is transparent black.
+    */
+    void EncodeColorBlock(const Block& block, bool punchThrough, std::uint8_t* out)
+    {
+        std::array<std::uint8_t, 4> low {255, 255, 255, 255};
+        std::array<std::uint8_t, 4> high {0, 0, 0, 0};
+        bool hasTransparent {false};
+        bool hasOpaque {false};
+
+        for (const auto& texel: block)
+        {
+            if (punchThrough && texel[3] < k_AlphaCutoff)
+            {
+                hasTransparent = true;
+                continue;
+            }
+
+            hasOpaque = true;
+            for (int channel {0}; channel < 3; ++channel)
+            {
+                low[channel]  = std::min(low[channel], texel[channel]);
+                high[channel] = std::max(high[channel], texel[channel]);
+            }
+        }
+
+        if (!hasOpaque)
+        {
+            // 3-color mode with every index transparent.
+            WriteLE(out, 0, 4);
+            WriteLE(out + 4, 0xFFFFFFFFu, 4);
+            return;
+        }
+
+        std::uint16_t color0 {To565(high)};
+        std::uint16_t color1 {To565(low)};
+
+        // color0 > color1 selects the 4-color mode, color0 <= color1 the 3-color mode.
+        const bool threeColor {hasTransparent};
+        if (threeColor == (color0 > color1))
+        {
+            std::swap(color0, color1);
+        }
+
+        const auto p0 {From565(color0)};
+        const auto p1 {From565(color1)};
+
+        std::array<std::array<int, 3>, 4> palette {p0, p1, {}, {}};
+        int candidates {3};
+        if (color0 > color1)
+        {
+            for (int channel {0}; channel < 3; ++channel)
+            {
+                palette[2][channel] = (2 * p0[channel] + p1[channel]) / 3;
+                palette[3][channel] = (p0[channel] + 2 * p1[channel]) / 3;
+            }
+            candidates = 4;
+        }
+        else
+        {
+            for (int channel {0}; channel < 3; ++channel)
+            {
+                palette[2][channel] = (p0[channel] + p1[channel]) / 2;
+            }
+        }
+
+        std::uint32_t indices {0};
+        for (std::size_t i {0}; i < block.size(); ++i)
+        {
+            const auto& texel {block[i]};
+
+            std::uint32_t best {3};
+            if (!(threeColor && texel[3] < k_AlphaCutoff))
+            {
+                int bestDistance {std::numeric_limits<int>::max()};
+                for (int candidate {0}; candidate < candidates; ++candidate)
+                {
+                    int distance {0};
+                    for (int channel {0}; channel < 3; ++channel)
+                    {
+                        const int delta {palette[candidate][channel] - texel[channel]};
+                        distance += delta * delta;
+                    }
+
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        best = static_cast<std::uint32_t>(candidate);
+                    }
+                }
+            }
+            indices |= best << (2 * i);
+        }
+
+        WriteLE(out, color0, 2);
+        WriteLE(out + 2, color1, 2);
+        WriteLE(out + 4, indices, 4);
+    }
+
+    /*
+    * BC3 alpha block, 8 interpolated alphas between the block's min and max.
+    */
+    void EncodeAlphaBlock(const Block& block, std::uint8_t* out)
+    {
+        int alpha0 {0};
+        int alpha1 {255};
+        for (const auto& texel: block)
+        {
+            alpha0 = std::max<int>(alpha0, texel[3]);
+            alpha1 = std::min<int>(alpha1, texel[3]);
+        }
+
+        std::array<int, 8> palette {alpha0, alpha1};
+        for (int i {1}; i <= 6; ++i)
+        {
+            palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+        }
+
+        std::uint64_t indices {0};
+        if (alpha0 > alpha1)
+        {
+            for (std::size_t i {0}; i < block.size(); ++i)
+            {
+                std::uint64_t best {0};
+                int bestDistance {256};
+                for (int candidate {0}; candidate < 8; ++candidate)
+                {
+                    const int distance {std::abs(palette[candidate] - block[i][3])};
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        best = static_cast<std::uint64_t>(candidate);
+                    }
+                }
+                indices |= best << (3 * i);
+            }
+        }
+
+        out[0] = static_cast<std::uint8_t>(alpha0);
+        out[1] = static_cast<std::uint8_t>(alpha1);
+        WriteLE(out + 2, indices, 6);
+    }
+
+    /*
+    * Compresses an RGBA level into 4x4 blocks, partial edge blocks repeat the last row or column.
+    */
+    std::vector<std::uint8_t> Compress(const Level& level, TexelFormat format)
+    {
+        const std::uint32_t blocksX {std::max(1u, (level.width + 3) / 4)};
+        const std::uint32_t blocksY {std::max(1u, (level.height + 3) / 4)};
+        const std::size_t blockBytes {format == TexelFormat::BC1 ? 8u : 16u};
+
+        std::vector<std::uint8_t> compressed(static_cast<std::size_t>(blocksX) * blocksY * blockBytes);
+        auto* out {compressed.data()};
+
+        for (std::uint32_t by {0}; by < blocksY; ++by)
+        {
+            for (std::uint32_t bx {0}; bx < blocksX; ++bx)
+            {
+                Block block;
+                for (std::uint32_t i {0}; i < 16; ++i)
+                {
+                    const std::uint32_t x {std::min(bx * 4 + i % 4, level.width - 1)};
+                    const std::uint32_t y {std::min(by * 4 + i / 4, level.height - 1)};
+                    std::memcpy(block[i].data(), &level.texels[(static_cast<std::size_t>(y) * level.width + x) * 4], 4);
+                }
+
+                if (format == TexelFormat::BC1)
+                {
+                    EncodeColorBlock(block, true, out);
+                }
+                else
+                {
+                    EncodeAlphaBlock(block, out);
+                    EncodeColorBlock(block, false, out + 8);
+                }
+                out += blockBytes;
+            }
+        }
+
+        return compressed;
+    }
+}// anonymous namespace
+
+TextureCooker::TextureCooker(CookOptions options):
+m_options(options)
+{}
+
+/*
+* Returns the '.g9tex' bytes for {imagePath}, or nothing if the image could not be decoded.
+*/
+std::optional<std::vector<std::byte>> TextureCooker::Cook(const std::filesystem::path& imagePath) const
+{
+    const bool compress {m_options.compression != Compression::None};
+
+    // Rows bottom to top, the same flip the runtime used to apply on every load.
+    stbi_set_flip_vertically_on_load(true);
+
+    int width {0}, height {0}, channels {0};
+    std::unique_ptr<unsigned char[], decltype(stbi_image_free)*>
+    pixels(stbi_load(imagePath.c_str(), &width, &height, &channels, compress ? 4 : 0), stbi_image_free);
+
+    if (!pixels)
+    {
+        std::println(stderr, "Failed to decode '{}': {}", imagePath.string(), stbi_failure_reason());
+        return std::nullopt;
+    }
+
+    if (compress)
+    {
+        channels = 4;
+    }
+
+    std::vector<Level> levels;
+    levels.push_back(Level{static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height),
+                           std::vector<std::uint8_t>(pixels.get(), pixels.get() + static_cast<std::size_t>(width) * height * channels)});
+
+    while (m_options.generateMipmaps && levels.size() < Renderer::k_MaxCookedMipLevels &&
+           (levels.back().width > 1 || levels.back().height > 1))
+    {
+        levels.push_back(Downsample(levels.back(), channels));
+    }
+
+    TexelFormat format {static_cast<TexelFormat>(channels)};
+    if (m_options.compression == Compression::BC1)
+    {
+        format = TexelFormat::BC1;
+    }
+    else if (m_options.compression == Compression::BC3)
+    {
+        format = TexelFormat::BC3;
+    }
+
+    if (compress)
+    {
+        for (auto& level: levels)
+        {
+            level.texels = Compress(level, format);
+        }
+    }
+
+    const Renderer::CookedTextureHeader header
+    {
+        .magic    = Renderer::k_CookedTextureMagic,
+        .version  = Renderer::k_CookedTextureVersion,
+        .format   = format,
+        .width    = static_cast<std::uint32_t>(width),
+        .height   = static_cast<std::uint32_t>(height),
+        .mipCount = static_cast<std::uint32_t>(levels.size()),
+    };
+
+    std::vector<Renderer::CookedMipLevel> table;
+    std::uint64_t offset {sizeof(header) + levels.size() * sizeof(Renderer::CookedMipLevel)};
+    for (const auto& level: levels)
+    {
+        table.push_back({level.width, level.height, offset, level.texels.size()});
+        offset += level.texels.size();
+    }
+
+    std::vector<std::byte> file(offset);
+    auto* out {file.data()};
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, table.data(), table.size() * sizeof(Renderer::CookedMipLevel));
+    out += table.size() * sizeof(Renderer::CookedMipLevel);
+
+    for (const auto& level: levels)
+    {
+        std::memcpy(out, level.texels.data(), level.texels.size());
+        out += level.texels.size();
+    }
+
+    return file;
+}
+
+/*
+* Cooks {imagePath} and writes it to {outputPath}, written to a temporary file first so a failed
+* write never leaves a truncated texture behind.
+*/
+bool TextureCooker::CookToFile(const std::filesystem::path& imagePath, const std::filesystem::path& outputPath) const
+{
+    const auto cooked {Cook(imagePath)};
+    if (!cooked)
+    {
+        return false;
+    }
+
+    std::error_code error;
+    if (outputPath.has_parent_path())
+    {
+        std::filesystem::create_directories(outputPath.parent_path(), error);
+    }
+
+    auto temporary {outputPath};
+    temporary += ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(cooked->data()), static_cast<std::streamsize>(cooked->size()));
+        if (!file)
+        {
+            std::println(stderr, "Failed to write '{}'.", temporary.string());
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, outputPath, error);
+    if (error)
+    {
+        std::println(stderr, "Failed to write '{}': {}", outputPath.string(), error.message());
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+
+    return true;
+}
+}// namespace Tools
@@ -0,0 +1,44 @@
+#ifndef TEXTURECOOKER_H
+#define TEXTURECOOKER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include "renderer/TextureFormat.h"
+
+namespace Tools
+{
+enum class Compression
+{
+    None,
+    BC1,
+    BC3,
+};
+
+struct CookOptions
+{
+    bool generateMipmaps {true};
+    Compression compression {Compression::None};
+};
+
+/*
+* Converts images into the '.g9tex' container: decoded once with stb, flipped for GL, mip chain
+* built on the CPU with a box filter, and optionally S3TC compressed.
+*/
+class TextureCooker
+{
+private:
+
+    CookOptions m_options;
+
+public:
+
+    explicit TextureCooker(CookOptions options = {});
+
+    std::optional<std::vector<std::byte>> Cook(const std::filesystem::path& imagePath) const;
+    bool CookToFile(const std::filesystem::path& imagePath, const std::filesystem::path& outputPath) const;
+};
+}// namespace Tools
+#endif
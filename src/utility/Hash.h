@@ -0,0 +1,48 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace Utility
+{
+/*
+ * FNV-1a hashes, usable at compile time for string literals. Not cryptographic; used for
+ * cache keys and name lookups.
+ */
+constexpr std::uint32_t Fnv1a32(std::string_view str, std::uint32_t seed = 2166136261u) noexcept
+{
+    std::uint32_t value {seed};
+    for (const char c: str)
+    {
+        value ^= static_cast<std::uint8_t>(c);
+        value *= 16777619u;
+    }
+    return value;
+}
+
+constexpr std::uint64_t Fnv1a64(std::string_view str, std::uint64_t seed = 14695981039346656037ull) noexcept
+{
+    std::uint64_t value {seed};
+    for (const char c: str)
+    {
+        value ^= static_cast<std::uint8_t>(c);
+        value *= 1099511628211ull;
+    }
+    return value;
+}
+
+inline std::uint64_t Fnv1a64(std::span<const std::byte> bytes, std::uint64_t seed = 14695981039346656037ull) noexcept
+{
+    std::uint64_t value {seed};
+    for (const std::byte b: bytes)
+    {
+        value ^= static_cast<std::uint8_t>(b);
+        value *= 1099511628211ull;
+    }
+    return value;
+}
+}// namespace Utility
+#endif
@@ -5,6 +5,8 @@
 #include <cstdio>
 #include <fstream>
 
+#include "utility/ResourcePack.h"
+
 namespace glm
 {
 void to_json(nlohmann::json& j, const glm::vec2& v)
@@ -29,15 +31,27 @@ std::expected<void, std::string> JsonFileHandler::Read()
 {
     try
     {
-        std::ifstream in;
-        in.exceptions(std::ios_base::badbit);
-        in.open(m_jsonFileName);
-        if (!in)
+        // Saved data on disk wins, the resource pack only holds the copy shipped with the game.
+        const auto* pack {GetMountedPack()};
+        if (const auto packed {pack ? pack->Find(m_jsonFileName) : std::span<const std::byte>{}};
+            !packed.empty() && !std::filesystem::exists(m_jsonFileName))
+        {
+            const auto* text {reinterpret_cast<const char*>(packed.data())};
+            m_jsonData = nlohmann::json::parse(text, text + packed.size());
+        }
+        else
         {
-            return std::unexpected(std::format("Failed to open file '{}'", m_jsonFileName.string()));
+            std::ifstream in;
+            in.exceptions(std::ios_base::badbit);
+            in.open(m_jsonFileName);
+            if (!in)
+            {
+                return std::unexpected(std::format("Failed to open file '{}'", m_jsonFileName.string()));
+            }
+
+            m_jsonData = nlohmann::json::parse(in);
         }
 
-        m_jsonData = nlohmann::json::parse(in);
         if (m_jsonData.is_null())
         {
             m_jsonData = nlohmann::json::object();
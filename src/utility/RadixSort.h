@@ -0,0 +1,192 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "utility/WorkerPool.h"
+
+namespace Utility
+{
+// Pairs below this count are always sorted on the calling thread.
+inline constexpr std::size_t k_MinParallelSortCount {32768};
+
+/*
+ * Temporary storage of RadixSortPairs(), resized as needed and kept by the caller so sorting
+ * allocates nothing once the sizes settle.
+ */
+template<std::unsigned_integral Key, typename Value>
+struct RadixSortScratch
+{
+    std::vector<Key> keys;
+    std::vector<Value> values;
+
+    // One per worker: bucket counts, then bucket offsets, and the OR and AND of the worker's keys.
+    std::vector<std::array<std::size_t, 256>> histograms;
+    std::vector<Key> anyBits;
+    std::vector<Key> allBits;
+};
+
+/*
+ * Stable LSD radix sort of {keys} with {values} moved alongside. Keys and values are two parallel
+ * arrays, so the counting reads stream through the keys alone. Bytes that are equal in every key
+ * are skipped.
+ *
+ * With a {pool} of more than one worker and at least k_MinParallelSortCount pairs, the arrays are
+ * split into contiguous chunks, one per worker, and each pass has three steps:
+ * - every worker counts its chunk;
+ * - worker 0 lays the bucket offsets out chunk by chunk, so equal keys keep their input order;
+ * - every worker scatters its chunk.
+ *
+ * @params
+ * keys, values: same size, sorted in place.
+ * scratch: temporary storage kept by the caller.
+ * pool: persistent workers shared with the caller, nullptr sorts on the calling thread.
+ */
+template<std::unsigned_integral Key, typename Value>
+void RadixSortPairs(std::vector<Key>& keys, std::vector<Value>& values, RadixSortScratch<Key, Value>& scratch, WorkerPool* pool = nullptr)
+{
+    constexpr std::size_t k_Passes {sizeof(Key)};
+    constexpr std::size_t k_Buckets {256};
+
+    assert(keys.size() == values.size());
+    const std::size_t count {keys.size()};
+    if (count < 2)
+    {
+        return;
+    }
+
+    const bool parallel {pool && pool->GetWorkerCount() > 1 && count >= k_MinParallelSortCount};
+    const std::size_t workers {parallel ? pool->GetWorkerCount() : 1};
+    const std::size_t chunk {(count + workers - 1) / workers};
+
+    auto& keyScratch {scratch.keys};
+    auto& valueScratch {scratch.values};
+    keyScratch.resize(count);
+    valueScratch.resize(count);
+
+    // Per-worker slots are written by their worker, read by the others after a Sync().
+    auto& histograms {scratch.histograms};
+    auto& anyBits {scratch.anyBits};
+    auto& allBits {scratch.allBits};
+    histograms.resize(workers);
+    anyBits.assign(workers, 0);
+    allBits.assign(workers, static_cast<Key>(~Key{0}));
+
+    auto sync = [&]()
+    {
+        if (parallel)
+        {
+            pool->Sync();
+        }
+    };
+
+    bool sortedInScratch {false}; // written by worker 0.
+
+    auto work = [&](std::size_t worker)
+    {
+        const std::size_t begin {std::min(worker * chunk, count)};
+        const std::size_t end {std::min(begin + chunk, count)};
+
+        Key any {0};
+        Key all {static_cast<Key>(~Key{0})};
+        for (std::size_t i {begin}; i < end; ++i)
+        {
+            any |= keys[i];
+            all &= keys[i];
+        }
+        if (begin == end)
+        {
+            all = any = keys[0]; // an empty chunk must not hide varying bits.
+        }
+        anyBits[worker] = any;
+        allBits[worker] = all;
+        sync();
+
+        // Every worker reduces the same values, so all of them skip the same passes and swap
+        // their buffer pointers in step.
+        for (std::size_t other {0}; other < workers; ++other)
+        {
+            any |= anyBits[other];
+            all &= allBits[other];
+        }
+        const Key varyingBits {static_cast<Key>(any ^ all)};
+
+        Key* sourceKeys {keys.data()};
+        Value* sourceValues {values.data()};
+        Key* destinationKeys {keyScratch.data()};
+        Value* destinationValues {valueScratch.data()};
+
+        for (std::size_t pass {0}; pass < k_Passes; ++pass)
+        {
+            const std::size_t shift {pass * 8};
+            if (((varyingBits >> shift) & 0xFF) == 0)
+            {
+                continue;
+            }
+
+            auto& histogram {histograms[worker]};
+            histogram.fill(0);
+            for (std::size_t i {begin}; i < end; ++i)
+            {
+                ++histogram[(sourceKeys[i] >> shift) & 0xFF];
+            }
+            sync();
+
+            if (worker == 0)
+            {
+                // Bucket-major, chunk-minor: chunk w's pairs in bucket b follow chunk w-1's.
+                std::size_t offset {0};
+                for (std::size_t bucket {0}; bucket < k_Buckets; ++bucket)
+                {
+                    for (std::size_t owner {0}; owner < workers; ++owner)
+                    {
+                        const std::size_t bucketCount {histograms[owner][bucket]};
+                        histograms[owner][bucket] = offset;
+                        offset += bucketCount;
+                    }
+                }
+            }
+            sync();
+
+            for (std::size_t i {begin}; i < end; ++i)
+            {
+                const std::size_t destination {histogram[(sourceKeys[i] >> shift) & 0xFF]++};
+                destinationKeys[destination]   = sourceKeys[i];
+                destinationValues[destination] = sourceValues[i];
+            }
+            sync();
+
+            std::swap(sourceKeys, destinationKeys);
+            std::swap(sourceValues, destinationValues);
+        }
+
+        if (worker == 0)
+        {
+            sortedInScratch = sourceKeys != keys.data();
+        }
+    };
+
+    if (parallel)
+    {
+        pool->Run(work);
+    }
+    else
+    {
+        work(0);
+    }
+
+    if (sortedInScratch)
+    {
+        keys.swap(keyScratch);
+        values.swap(valueScratch);
+    }
+}
+}// namespace Utility
+#endif
@@ -0,0 +1,241 @@
+#include "utility/ResourcePack.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <print>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "utility/Hash.h"
+
+namespace Utility
+{
+namespace
+{
+    std::unique_ptr<ResourcePack> g_mountedPack;
+}// anonymous namespace
+
+std::string ResourceKey(const std::filesystem::path& path)
+{
+    return path.lexically_normal().generic_string();
+}
+
+/*
+* Maps the whole pack and validates its table of contents. The descriptor is closed right after
+* mapping, the mapping keeps the file alive.
+*/
+ResourcePack::ResourcePack(const std::filesystem::path& packPath):
+m_base(nullptr),
+m_size(0),
+m_names(nullptr)
+{
+    const int file {::open(packPath.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (file < 0)
+    {
+        throw std::runtime_error(std::format("Failed to open resource pack '{}'.", packPath.string()));
+    }
+
+    struct stat status {};
+    void* mapping {MAP_FAILED};
+    if (::fstat(file, &status) == 0 && status.st_size > 0)
+    {
+        m_size  = static_cast<std::size_t>(status.st_size);
+        mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    ::close(file);
+
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error(std::format("Failed to map resource pack '{}'.", packPath.string()));
+    }
+    m_base = static_cast<const std::byte*>(mapping);
+
+    auto fail = [this, &packPath](std::string_view reason)
+    {
+        ::munmap(const_cast<std::byte*>(m_base), m_size);
+        return std::runtime_error(std::format("Resource pack '{}' {}.", packPath.string(), reason));
+    };
+
+    if (m_size < sizeof(ResourcePackHeader))
+    {
+        throw fail("is truncated");
+    }
+
+    ResourcePackHeader header;
+    std::memcpy(&header, m_base, sizeof(header));
+
+    if (header.magic != k_ResourcePackMagic || header.version != k_ResourcePackVersion)
+    {
+        throw fail("has an unknown version, pack it again");
+    }
+
+    const std::uint64_t entriesEnd {header.entriesOffset + std::uint64_t{header.entryCount} * sizeof(ResourcePackEntry)};
+    if (header.entriesOffset % alignof(ResourcePackEntry) != 0 || entriesEnd > m_size || header.namesOffset > m_size)
+    {
+        throw fail("has a corrupt table of contents");
+    }
+
+    m_entries = {reinterpret_cast<const ResourcePackEntry*>(m_base + header.entriesOffset), header.entryCount};
+    m_names   = reinterpret_cast<const char*>(m_base + header.namesOffset);
+
+    for (const auto& entry: m_entries)
+    {
+        if (entry.offset + entry.size > m_size || header.namesOffset + entry.nameOffset + entry.nameLength > m_size)
+        {
+            throw fail("has an entry outside the file");
+        }
+    }
+}
+
+ResourcePack::~ResourcePack()
+{
+    if (m_base)
+    {
+        ::munmap(const_cast<std::byte*>(m_base), m_size);
+    }
+}
+
+std::string_view ResourcePack::GetName(const ResourcePackEntry& entry) const noexcept
+{
+    return {m_names + entry.nameOffset, entry.nameLength};
+}
+
+/*
+* Returns a view of the resource's bytes inside the mapping, empty if the pack does not hold it.
+*/
+std::span<const std::byte> ResourcePack::Find(const std::filesystem::path& path) const
+{
+    const auto key {ResourceKey(path)};
+    const auto hash {Fnv1a64(key)};
+
+    auto iter {std::ranges::lower_bound(m_entries, hash, {}, &ResourcePackEntry::pathHash)};
+    for (; iter != m_entries.end() && iter->pathHash == hash; ++iter)
+    {
+        if (GetName(*iter) == key)
+        {
+            return {m_base + iter->offset, static_cast<std::size_t>(iter->size)};
+        }
+    }
+
+    return {};
+}
+
+bool ResourcePack::Contains(const std::filesystem::path& path) const
+{
+    const auto key {ResourceKey(path)};
+    const auto hash {Fnv1a64(key)};
+
+    auto iter {std::ranges::lower_bound(m_entries, hash, {}, &ResourcePackEntry::pathHash)};
+    for (; iter != m_entries.end() && iter->pathHash == hash; ++iter)
+    {
+        if (GetName(*iter) == key)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::size_t ResourcePack::GetEntryCount() const noexcept
+{
+    return m_entries.size();
+}
+
+ResourceData::ResourceData(std::span<const std::byte> mapped):
+m_bytes(mapped)
+{}
+
+ResourceData::ResourceData(std::vector<std::byte> storage):
+m_storage(std::move(storage))
+{
+    m_bytes = m_storage;
+}
+
+std::span<const std::byte> ResourceData::GetBytes() const noexcept
+{
+    return m_bytes;
+}
+
+std::string_view ResourceData::GetText() const noexcept
+{
+    return {reinterpret_cast<const char*>(m_bytes.data()), m_bytes.size()};
+}
+
+bool ResourceData::IsMapped() const noexcept
+{
+    return m_storage.empty() && !m_bytes.empty();
+}
+
+/*
+* Mounts {packPath} as the process-wide pack, replacing any pack mounted before. Returns false and
+* keeps using loose files if the pack cannot be opened.
+*/
+bool MountResourcePack(const std::filesystem::path& packPath)
+{
+    try
+    {
+        g_mountedPack = std::make_unique<ResourcePack>(packPath);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::println(stderr, "{}", e.what());
+        g_mountedPack.reset();
+        return false;
+    }
+}
+
+void UnmountResourcePack()
+{
+    g_mountedPack.reset();
+}
+
+const ResourcePack* GetMountedPack() noexcept
+{
+    return g_mountedPack.get();
+}
+
+/*
+* Returns the resource from the mounted pack without copying, or reads the loose file.
+*/
+std::expected<ResourceData, std::string> ReadResource(const std::filesystem::path& path)
+{
+    if (g_mountedPack)
+    {
+        if (const auto bytes {g_mountedPack->Find(path)}; !bytes.empty())
+        {
+            return ResourceData{bytes};
+        }
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        return std::unexpected(std::format("Failed to open file for reading: {}", path.string()));
+    }
+
+    std::vector<std::byte> contents(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+    if (!file)
+    {
+        return std::unexpected(std::format("Failed to read file: {}", path.string()));
+    }
+
+    return ResourceData{std::move(contents)};
+}
+
+bool ResourceExists(const std::filesystem::path& path)
+{
+    return (g_mountedPack && g_mountedPack->Contains(path)) || std::filesystem::exists(path);
+}
+}// namespace Utility
@@ -0,0 +1,116 @@
+#ifndef RESOURCEPACK_H
+#define RESOURCEPACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Utility
+{
+/*
+* '.g9pack' archive layout, written by 'gamenine-cook --pack':
+*   ResourcePackHeader | blobs, each aligned to k_ResourcePackAlignment | entries | names
+* Entries are sorted by (pathHash, name) so a lookup is a binary search on the hash. Names are the
+* resource paths as loaders ask for them, ex. "resources/shaders/sprite.vert".
+*/
+constexpr std::uint32_t k_ResourcePackMagic     {0x4B503947}; // 'G9PK' little-endian.
+constexpr std::uint32_t k_ResourcePackVersion   {1};
+constexpr std::uint64_t k_ResourcePackAlignment {16};
+
+struct ResourcePackHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+    std::uint64_t entriesOffset;
+    std::uint64_t namesOffset;
+};
+static_assert(sizeof(ResourcePackHeader) == 32);
+
+struct ResourcePackEntry
+{
+    std::uint64_t pathHash; // Fnv1a64 of the name.
+    std::uint64_t offset;   // blob, from the start of the file.
+    std::uint64_t size;
+    std::uint32_t nameOffset; // from namesOffset.
+    std::uint32_t nameLength;
+};
+static_assert(sizeof(ResourcePackEntry) == 32);
+
+// Key resources are stored and looked up by: normalized, forward slashes.
+std::string ResourceKey(const std::filesystem::path& path);
+
+/*
+* Read-only view of a '.g9pack' file, memory-mapped once; lookups return spans straight into the
+* mapping so nothing is copied and pages are only read when touched.
+*/
+class ResourcePack
+{
+private:
+
+    const std::byte* m_base;
+    std::size_t m_size;
+
+    std::span<const ResourcePackEntry> m_entries;
+    const char* m_names;
+
+    std::string_view GetName(const ResourcePackEntry& entry) const noexcept;
+
+public:
+
+    explicit ResourcePack(const std::filesystem::path& packPath);
+    ~ResourcePack();
+
+    ResourcePack(const ResourcePack&)            = delete;
+    ResourcePack& operator=(const ResourcePack&) = delete;
+    ResourcePack(ResourcePack&&)                 = delete;
+    ResourcePack& operator=(ResourcePack&&)      = delete;
+
+    std::span<const std::byte> Find(const std::filesystem::path& path) const;
+    bool Contains(const std::filesystem::path& path) const;
+
+    std::size_t GetEntryCount() const noexcept;
+};
+
+/*
+* Contents of a resource: a view into the mounted pack, or a file read from disk when no pack is
+* mounted or the pack does not hold it. Move-only, the view stays valid while this lives.
+*/
+class ResourceData
+{
+private:
+
+    std::span<const std::byte> m_bytes;
+    std::vector<std::byte> m_storage; // loose file contents, empty when mapped.
+
+public:
+
+    ResourceData() = default;
+    explicit ResourceData(std::span<const std::byte> mapped);
+    explicit ResourceData(std::vector<std::byte> storage);
+
+    ResourceData(ResourceData&&) noexcept            = default;
+    ResourceData& operator=(ResourceData&&) noexcept = default;
+    ResourceData(const ResourceData&)                = delete;
+    ResourceData& operator=(const ResourceData&)     = delete;
+
+    std::span<const std::byte> GetBytes() const noexcept;
+    std::string_view GetText() const noexcept;
+    bool IsMapped() const noexcept;
+};
+
+// Process-wide pack, mount it before any loader threads start.
+bool MountResourcePack(const std::filesystem::path& packPath);
+void UnmountResourcePack();
+const ResourcePack* GetMountedPack() noexcept;
+
+std::expected<ResourceData, std::string> ReadResource(const std::filesystem::path& path);
+bool ResourceExists(const std::filesystem::path& path);
+}// namespace Utility
+#endif
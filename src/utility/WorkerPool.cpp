@@ -0,0 +1,91 @@
+#include "utility/WorkerPool.h"
+
+#include <algorithm>
+
+namespace Utility
+{
+/*
+* @params:
+* workerCount: threads working on every job, the calling thread included; 1 starts no threads.
+*/
+WorkerPool::WorkerPool(std::size_t workerCount):
+m_workerCount(std::max<std::size_t>(workerCount, 1)),
+m_invoke(nullptr),
+m_task(nullptr),
+m_stop(false),
+m_start(static_cast<std::ptrdiff_t>(m_workerCount)),
+m_done(static_cast<std::ptrdiff_t>(m_workerCount)),
+m_sync(static_cast<std::ptrdiff_t>(m_workerCount))
+{
+    m_threads.reserve(m_workerCount - 1);
+    for (std::size_t worker {1}; worker < m_workerCount; ++worker)
+    {
+        m_threads.emplace_back([this, worker]{WorkerLoop(worker);});
+    }
+}
+
+/*
+* Releases the parked workers with the stop flag set, they are joined by m_threads.
+*/
+WorkerPool::~WorkerPool()
+{
+    if (m_threads.empty())
+    {
+        return;
+    }
+
+    m_stop = true;
+    m_start.arrive_and_wait();
+}
+
+void WorkerPool::WorkerLoop(std::size_t worker)
+{
+    while (true)
+    {
+        m_start.arrive_and_wait();
+        if (m_stop)
+        {
+            return;
+        }
+
+        m_invoke(m_task, worker);
+        m_done.arrive_and_wait();
+    }
+}
+
+/*
+* The barriers order the job's writes before the workers read them, and the workers' writes
+* before Run() returns.
+*/
+void WorkerPool::Dispatch()
+{
+    if (!m_threads.empty())
+    {
+        m_start.arrive_and_wait();
+    }
+
+    m_invoke(m_task, 0);
+
+    if (!m_threads.empty())
+    {
+        m_done.arrive_and_wait();
+    }
+}
+
+/*
+* Waits inside a task until every worker of the job reached the same point, for tasks made of
+* several dependent steps. Every worker must call it the same number of times.
+*/
+void WorkerPool::Sync()
+{
+    if (!m_threads.empty())
+    {
+        m_sync.arrive_and_wait();
+    }
+}
+
+std::size_t WorkerPool::GetWorkerCount() const noexcept
+{
+    return m_workerCount;
+}
+}// namespace Utility
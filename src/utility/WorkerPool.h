@@ -0,0 +1,65 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <barrier>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Utility
+{
+/*
+* Fixed set of threads parked on a barrier between jobs, for per-frame work that is split into one
+* range per worker. Run() wakes them, runs the task on the calling thread as worker 0 as well, and
+* returns once every worker finished; nothing is created or allocated per job.
+*
+* Main thread only: one Run() at a time, from the thread that owns the pool.
+*/
+class WorkerPool
+{
+private:
+
+    std::size_t m_workerCount; // the calling thread included.
+
+    // The current job, type-erased without allocating; published to the workers by m_start.
+    void (*m_invoke)(void* task, std::size_t worker);
+    void* m_task;
+    bool m_stop;
+
+    std::barrier<> m_start;
+    std::barrier<> m_done;
+    std::barrier<> m_sync;
+
+    // Declared last so the threads are joined before the barriers they wait on are destroyed.
+    std::vector<std::jthread> m_threads;
+
+    void WorkerLoop(std::size_t worker);
+    void Dispatch();
+
+public:
+
+    explicit WorkerPool(std::size_t workerCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&)            = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&)                 = delete;
+    WorkerPool& operator=(WorkerPool&&)      = delete;
+
+    /*
+    * Calls task(worker) once for every worker in [0, GetWorkerCount()) and waits for all of them.
+    */
+    template<typename Task>
+    void Run(Task& task)
+    {
+        m_task   = &task;
+        m_invoke = [](void* erased, std::size_t worker){(*static_cast<Task*>(erased))(worker);};
+        Dispatch();
+    }
+
+    void Sync();
+
+    std::size_t GetWorkerCount() const noexcept;
+};
+}// namespace Utility
+#endif